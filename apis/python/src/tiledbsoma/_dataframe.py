@@ -396,7 +396,7 @@ class DataFrame(SOMAArray, somacore.DataFrame):
         if platform_config is not None:
             config = context.tiledb_config.copy()
             config.update(platform_config)
-            context = clib.SOMAContext(config)
+            context = clib.SOMAContext.cached(config)
 
         sr = clib.SOMADataFrame.open(
             uri=handle.uri,
@@ -194,7 +194,7 @@ class DenseNDArray(NDArray, somacore.DenseNDArray):
         if platform_config is not None:
             config = context.tiledb_config.copy()
             config.update(platform_config)
-            context = clib.SOMAContext(config)
+            context = clib.SOMAContext.cached(config)
 
         sr = clib.SOMADenseNDArray.open(
             uri=handle.uri,
@@ -15,15 +15,31 @@ if TYPE_CHECKING:
 
 IndexerDataType = Union[
     npt.NDArray[np.int64],
+    npt.NDArray[np.int32],
+    npt.NDArray[np.uint32],
+    npt.NDArray[np.uint64],
     pa.Array,
     pa.IntegerArray,
+    pa.StringArray,
     pd.Series,
     pd.arrays.IntegerArray,
     pa.ChunkedArray,
     List[int],
+    List[str],
 ]
 
 
+def _as_pyarrow_if_strings(data: IndexerDataType) -> IndexerDataType:
+    """Converts string keys to a pyarrow array, which the indexer reads without
+    creating Python strings. Other keys are returned as is."""
+    if isinstance(data, (pd.Series, pd.Index, np.ndarray)):
+        if data.dtype.kind in "OSU" or isinstance(data.dtype, pd.StringDtype):
+            return pa.array(data)
+    elif isinstance(data, list) and data and isinstance(data[0], str):
+        return pa.array(data)
+    return data
+
+
 def tiledbsoma_build_index(
     data: IndexerDataType, *, context: Optional["SOMATileDBContext"] = None
 ) -> IndexLike:
@@ -45,7 +61,7 @@ def tiledbsoma_build_index(
 
 
 class IntIndexer:
-    """A re-indexer for unique integer indices.
+    """A re-indexer for unique integer or string indices.
 
     Lifecycle:
         Experimental.
@@ -58,7 +74,7 @@ class IntIndexer:
 
         Args:
            data:
-               Integer keys used to build the index (hash) table.
+               Integer or string keys used to build the index (hash) table.
            context:
                ``SOMATileDBContext`` object containing concurrecy level.
 
@@ -69,7 +85,13 @@ class IntIndexer:
         self._reindexer = clib.IntIndexer(
             None if self._context is None else self._context.native_context
         )
-        self._reindexer.map_locations(data)
+        data = _as_pyarrow_if_strings(data)
+        if isinstance(data, pa.ChunkedArray):
+            data = data.combine_chunks()
+        if isinstance(data, pa.Array):
+            self._reindexer.map_locations_pyarrow(data)
+        else:
+            self._reindexer.map_locations(data)
 
     def get_indexer(self, target: IndexerDataType) -> Any:
         """Compute underlying indices of index for target data.
@@ -79,6 +101,7 @@ class IntIndexer:
         Args:
             target: Data to return re-index data for.
         """
+        target = _as_pyarrow_if_strings(target)
         return (
             self._reindexer.get_indexer_pyarrow(target)
             if isinstance(target, (pa.Array, pa.ChunkedArray))
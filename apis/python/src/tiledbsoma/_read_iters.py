@@ -401,18 +401,50 @@ class BlockwiseScipyReadIter(BlockwiseReadIterBase[BlockwiseScipyReadIterResult]
         """Private. Compressed sparse variants"""
         assert self.compress
         assert self.major_axis not in self.reindex_disable_on_axis
-        for ((i, j), d), indices in self._maybe_eager_iterator(
-            self._sorted_tbl_reader(_pool), _pool
+        yield from self._maybe_eager_iterator(self._cs_block_reader(), _pool)
+
+    def _cs_block_reader(
+        self,
+    ) -> Iterator[Tuple[Union[sparse.csr_matrix, sparse.csc_matrix], IndicesType],]:
+        """Private. Build each block natively from the COO results, reindexing
+        and compressing them without intermediate Arrow tables"""
+        assert self.context is not None
+        cls = sparse.csr_matrix if self.major_axis == 0 else sparse.csc_matrix
+        kwargs: Dict[str, object] = {"result_order": self.sr.result_order}
+        for coord_chunk in _coords_strider(
+            self.coords[self.major_axis],
+            self.sr.shape[self.major_axis],
+            self.size[0],
         ):
-            major_coords = indices[self.major_axis]
-            minor_coords = indices[self.minor_axis]
-            cls = sparse.csr_matrix if self.major_axis == 0 else sparse.csc_matrix
-            sp = cls(
-                sparse.coo_matrix(
-                    (d, (i, j)), shape=self._mk_shape(major_coords, minor_coords)
-                )
+            self.sr.reset(**kwargs)
+            step_coords = list(self.coords)
+            step_coords[self.major_axis] = coord_chunk
+            self.array._set_reader_coords(self.sr, step_coords)
+
+            joinids = [j.to_numpy() for j in self.joinids]
+            joinids[self.major_axis] = coord_chunk
+            indexers: List[Optional[clib.IntIndexer]] = [None, None]
+            indexers[self.major_axis] = IntIndexer(
+                coord_chunk, context=self.context
+            )._reindexer
+            if self.minor_axis in self.minor_axes_indexer:
+                indexers[self.minor_axis] = self.minor_axes_indexer[
+                    self.minor_axis
+                ]._reindexer
+
+            shape = self._mk_shape(joinids[self.major_axis], joinids[self.minor_axis])
+            matrix = clib.CompressedSparseMatrix(
+                self.context.native_context,
+                shape[0],
+                shape[1],
+                csr=self.major_axis == 0,
+                row_indexer=indexers[0],
+                col_indexer=indexers[1],
             )
-            yield sp, indices
+            matrix.append_reads(self.sr)
+            matrix.compress()
+            sp = cls((matrix.data(), matrix.indices(), matrix.indptr()), shape=shape)
+            yield sp, (joinids[0], joinids[1])
 
 
 class SparseTensorReadIterBase(somacore.ReadIter[_RT], metaclass=abc.ABCMeta):
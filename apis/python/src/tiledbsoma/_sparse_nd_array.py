@@ -226,7 +226,7 @@ class SparseNDArray(NDArray, somacore.SparseNDArray):
         if platform_config is not None:
             config = context.tiledb_config.copy()
             config.update(platform_config)
-            context = clib.SOMAContext(config)
+            context = clib.SOMAContext.cached(config)
 
         sr = clib.SOMASparseNDArray.open(
             uri=handle.uri,
@@ -151,6 +151,25 @@ bool is_tdb_str(tiledb_datatype_t type) {
     }
 }
 
+/**
+ * @brief Import an Arrow array and schema into a pyarrow table.
+ *
+ * @param arrow_table Struct array of the columns and its schema
+ * @return py::object
+ */
+py::object to_pyarrow_table(ArrowTable arrow_table) {
+    auto pa = py::module::import("pyarrow");
+    auto pa_batch_import = pa.attr("RecordBatch").attr("_import_from_c");
+    auto pa_table_from_batches = pa.attr("Table").attr("from_batches");
+
+    // Import all the columns at once, as a struct array
+    auto& [pa_array, pa_schema] = arrow_table;
+    auto batch = pa_batch_import(
+        py::capsule(pa_array.get()), py::capsule(pa_schema.get()));
+
+    return pa_table_from_batches(py::make_tuple(batch));
+}
+
 /**
  * @brief Convert ArrayBuffers to Arrow table.
  *
@@ -158,24 +177,14 @@ bool is_tdb_str(tiledb_datatype_t type) {
  * @return py::object
  */
 py::object _buffer_to_table(std::shared_ptr<ArrayBuffers> buffers) {
-    auto pa = py::module::import("pyarrow");
-    auto pa_table_from_arrays = pa.attr("Table").attr("from_arrays");
-    auto pa_array_import = pa.attr("Array").attr("_import_from_c");
-    auto pa_schema_import = pa.attr("Schema").attr("_import_from_c");
-
-    py::list array_list;
-    py::list names;
-
-    for (auto& name : buffers->names()) {
-        auto column = buffers->at(name);
-        auto [pa_array, pa_schema] = ArrowAdapter::to_arrow(column);
-        auto array = pa_array_import(
-            py::capsule(pa_array.get()), py::capsule(pa_schema.get()));
-        array_list.append(array);
-        names.append(name);
+    // Build the Arrow arrays without holding the GIL, it is only needed to
+    // import them into pyarrow
+    ArrowTable arrow_table;
+    {
+        py::gil_scoped_release release;
+        arrow_table = ArrowAdapter::to_arrow(buffers);
     }
-
-    return pa_table_from_arrays(array_list, names);
+    return to_pyarrow_table(std::move(arrow_table));
 }
 
 std::optional<py::object> to_table(
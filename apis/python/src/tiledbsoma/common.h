@@ -41,6 +41,19 @@ bool is_tdb_str(tiledb_datatype_t type);
 std::optional<py::object> to_table(
     std::optional<std::shared_ptr<ArrayBuffers>> buffers);
 
+/**
+ * @brief Wrap a static factory returning a std::unique_ptr, so that it can be
+ * bound for a class held by std::shared_ptr.
+ */
+template <typename T, typename... Args>
+auto shared_factory(std::unique_ptr<T> (*factory)(Args...)) {
+    return [factory](Args... args) {
+        return std::shared_ptr<T>(factory(std::forward<Args>(args)...));
+    };
+}
+
+py::object to_pyarrow_table(ArrowTable arrow_table);
+
 py::dict meta(std::map<std::string, MetadataValue> metadata_mapping);
 void set_metadata(
     SOMAObject& soma_object, const std::string& key, py::array value);
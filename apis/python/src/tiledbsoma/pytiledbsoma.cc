@@ -58,6 +58,19 @@ PYBIND11_MODULE(pytiledbsoma, m) {
         .value("rowmajor", ResultOrder::rowmajor)
         .value("colmajor", ResultOrder::colmajor);
 
+    py::enum_<PointSelection>(m, "PointSelection")
+        .value("automatic", PointSelection::automatic)
+        .value("points", PointSelection::points)
+        .value("ranges", PointSelection::ranges)
+        .value("bounding_range", PointSelection::bounding_range);
+
+    py::enum_<AggregateOp>(m, "AggregateOp")
+        .value("sum", AggregateOp::sum)
+        .value("mean", AggregateOp::mean)
+        .value("min", AggregateOp::min)
+        .value("max", AggregateOp::max)
+        .value("count", AggregateOp::count);
+
     py::enum_<URIType>(m, "URIType")
         .value("automatic", URIType::automatic)
         .value("absolute", URIType::absolute)
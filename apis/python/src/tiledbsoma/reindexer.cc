@@ -47,15 +47,19 @@ using namespace tiledbsoma;
  * @param lookups input values to be looked up
  * @return looked up values
  */
+template <typename T>
 py::array_t<int64_t> get_indexer_general(
-    IntIndexer& indexer, py::array_t<int64_t> lookups) {
+    IntIndexer& indexer, py::array_t<T> lookups) {
     auto input_buffer = lookups.request();
-    int64_t* input_ptr = static_cast<int64_t*>(input_buffer.ptr);
+    T* input_ptr = static_cast<T*>(input_buffer.ptr);
     size_t size = input_buffer.shape[0];
     auto results = py::array_t<int64_t>(size);
     auto results_buffer = results.request();
     int64_t* results_ptr = static_cast<int64_t*>(results_buffer.ptr);
-    indexer.lookup(input_ptr, results_ptr, size);
+    {
+        py::gil_scoped_release release;
+        indexer.lookup(input_ptr, results_ptr, size);
+    }
     return results;
 }
 
@@ -77,6 +81,91 @@ void extract_py_array_schema(
     object.attr("_export_to_c")(arrow_array_ptr, arrow_schema_ptr);
 }
 
+/***
+ * String keys of an Arrow string or binary array
+ */
+template <typename O>
+struct ArrowStringKeys {
+    const char* data;
+    const O* offsets;
+};
+
+/***
+ * Call fn with the keys of a pyarrow array, either as a pointer to integers or
+ * as ArrowStringKeys, and with the number of keys
+ * @param array pyarrow array
+ * @param fn callable taking the keys and their number
+ */
+template <typename Fn>
+void visit_py_arrow_keys(const pybind11::handle array, Fn fn) {
+    ArrowSchema arrow_schema;
+    ArrowArray arrow_array;
+    extract_py_array_schema(array, arrow_array, arrow_schema);
+
+    std::string format(arrow_schema.format);
+    auto offset = arrow_array.offset;
+    size_t size = arrow_array.length;
+    const void** buffers = arrow_array.buffers;
+    auto data = static_cast<const char*>(buffers[2]);
+    try {
+        if (arrow_array.null_count > 0) {
+            throw TileDBSOMAError("[IntIndexer] Keys cannot be null");
+        }
+        if (format == "l") {
+            fn(static_cast<const int64_t*>(buffers[1]) + offset, size);
+        } else if (format == "L") {
+            fn(static_cast<const uint64_t*>(buffers[1]) + offset, size);
+        } else if (format == "i") {
+            fn(static_cast<const int32_t*>(buffers[1]) + offset, size);
+        } else if (format == "I") {
+            fn(static_cast<const uint32_t*>(buffers[1]) + offset, size);
+        } else if (format == "s") {
+            fn(static_cast<const int16_t*>(buffers[1]) + offset, size);
+        } else if (format == "S") {
+            fn(static_cast<const uint16_t*>(buffers[1]) + offset, size);
+        } else if (format == "c") {
+            fn(static_cast<const int8_t*>(buffers[1]) + offset, size);
+        } else if (format == "C") {
+            fn(static_cast<const uint8_t*>(buffers[1]) + offset, size);
+        } else if (format == "u" || format == "z") {
+            fn(ArrowStringKeys<uint32_t>{
+                   data, static_cast<const uint32_t*>(buffers[1]) + offset},
+               size);
+        } else if (format == "U" || format == "Z") {
+            fn(ArrowStringKeys<uint64_t>{
+                   data, static_cast<const uint64_t*>(buffers[1]) + offset},
+               size);
+        } else {
+            throw TileDBSOMAError(
+                "[IntIndexer] Unsupported key type '" + format + "'");
+        }
+    } catch (...) {
+        arrow_schema.release(&arrow_schema);
+        arrow_array.release(&arrow_array);
+        throw;
+    }
+    arrow_schema.release(&arrow_schema);
+    arrow_array.release(&arrow_array);
+}
+
+/***
+ * Map the keys of a pyarrow array of integers or strings
+ * @param indexer reference to the indexer
+ * @param py_arrow_array pyarrow array of keys
+ */
+void map_locations_py_arrow(IntIndexer& indexer, py::object py_arrow_array) {
+    visit_py_arrow_keys(py_arrow_array, [&indexer](auto keys, size_t size) {
+        // The keys are Arrow buffers exported by pyarrow, no Python object
+        // is touched while mapping them
+        py::gil_scoped_release release;
+        if constexpr (std::is_pointer_v<decltype(keys)>) {
+            indexer.map_locations(keys, size);
+        } else {
+            indexer.map_locations(keys.data, keys.offsets, size);
+        }
+    });
+}
+
 /***
  * Handle pyarrow-based lookup for Re-indexer
  * @param indexer reference to the indexer
@@ -90,7 +179,7 @@ py::array_t<int64_t> get_indexer_py_arrow(
         !py::hasattr(py_arrow_array, "chunks") &&
         !py::hasattr(py_arrow_array, "combine_chunks")) {
         // Handle the general case (no py arrow objects)
-        return get_indexer_general(indexer, py_arrow_array);
+        return get_indexer_general<int64_t>(indexer, py_arrow_array);
     }
 
     py::list array_chunks;
@@ -120,16 +209,19 @@ py::array_t<int64_t> get_indexer_py_arrow(
     // Write output (one chunk at a time)
     int write_offset = 0;
     for (const pybind11::handle array : array_chunks) {
-        ArrowSchema arrow_schema;
-        ArrowArray arrow_array;
-        extract_py_array_schema(array, arrow_array, arrow_schema);
-        auto input_ptr = (int64_t*)arrow_array.buffers[1];
-        indexer.lookup(
-            input_ptr, results_ptr + write_offset, arrow_array.length);
-        write_offset += arrow_array.length;
-
-        arrow_schema.release(&arrow_schema);
-        arrow_array.release(&arrow_array);
+        visit_py_arrow_keys(array, [&](auto keys, size_t size) {
+            py::gil_scoped_release release;
+            if constexpr (std::is_pointer_v<decltype(keys)>) {
+                indexer.lookup(keys, results_ptr + write_offset, size);
+            } else {
+                indexer.lookup(
+                    keys.data,
+                    keys.offsets,
+                    results_ptr + write_offset,
+                    size);
+            }
+            write_offset += size;
+        });
     }
     return results;
 }
@@ -143,12 +235,37 @@ void load_reindexer(py::module& m) {
         .def(
             "map_locations",
             [](IntIndexer& indexer, py::array_t<int64_t> keys) {
+                py::gil_scoped_release release;
+                indexer.map_locations(keys.data(), keys.size());
+            })
+        .def(
+            "map_locations",
+            [](IntIndexer& indexer, py::array_t<int32_t> keys) {
+                py::gil_scoped_release release;
+                indexer.map_locations(keys.data(), keys.size());
+            })
+        .def(
+            "map_locations",
+            [](IntIndexer& indexer, py::array_t<uint32_t> keys) {
+                py::gil_scoped_release release;
+                indexer.map_locations(keys.data(), keys.size());
+            })
+        .def(
+            "map_locations",
+            [](IntIndexer& indexer, py::array_t<uint64_t> keys) {
+                py::gil_scoped_release release;
                 indexer.map_locations(keys.data(), keys.size());
             })
+        // Map integer or string keys from a pyarrow array without
+        // converting them to Python objects
+        .def("map_locations_pyarrow", map_locations_py_arrow)
         // Perform lookup for a large input array of keys and writes the
         // looked up values into previously allocated array (works for the
         // cases in which python and R pre-allocate the array)
-        .def("get_indexer_general", get_indexer_general)
+        .def("get_indexer_general", get_indexer_general<int64_t>)
+        .def("get_indexer_general", get_indexer_general<int32_t>)
+        .def("get_indexer_general", get_indexer_general<uint32_t>)
+        .def("get_indexer_general", get_indexer_general<uint64_t>)
         // If the input is not arrow (does not have _export_to_c attribute),
         // it will be handled using a general input method.
         .def("get_indexer_pyarrow", get_indexer_py_arrow);
@@ -51,6 +51,7 @@ void write(SOMAArray& array, py::handle py_batch, bool sort_coords = true) {
         std::make_unique<ArrowArray>(arrow_array));
 
     try {
+        py::gil_scoped_release release;
         array.write(sort_coords);
     } catch (const std::exception& e) {
         TPY_ERROR_LOC(e.what());
@@ -76,14 +77,183 @@ void write_coords(
     array.set_column_data("soma_data", data.size(), (const void*)data_info.ptr);
 
     try {
+        py::gil_scoped_release release;
         array.write(sort_coords);
     } catch (const std::exception& e) {
         TPY_ERROR_LOC(e.what());
     }
 }
 
+/**
+ * @brief Whether the element at a position of an Arrow array is valid.
+ */
+bool arrow_is_valid(const ArrowArray& arrow_array, int64_t i) {
+    auto validity = static_cast<const uint8_t*>(arrow_array.buffers[0]);
+    if (arrow_array.null_count == 0 || validity == nullptr) {
+        return true;
+    }
+    auto bit = arrow_array.offset + i;
+    return validity[bit / 8] & (1 << (bit % 8));
+}
+
+/**
+ * @brief Points of a fixed-width Arrow array. They are read in place from the
+ * data buffer, unless the array has nulls, which are dropped into `copy`.
+ */
+template <typename T>
+tcb::span<T> arrow_points(const ArrowArray& arrow_array, std::vector<T>& copy) {
+    // The buffer is not modified, set_dim_points takes a span of non-const T
+    auto data = static_cast<T*>(const_cast<void*>(arrow_array.buffers[1])) +
+                arrow_array.offset;
+    size_t length = arrow_array.length;
+    if (arrow_array.null_count == 0 || arrow_array.buffers[0] == nullptr) {
+        return tcb::span<T>(data, length);
+    }
+    copy.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+        if (arrow_is_valid(arrow_array, i)) {
+            copy.push_back(data[i]);
+        }
+    }
+    return tcb::span<T>(copy.data(), copy.size());
+}
+
+/**
+ * @brief Points of an Arrow string or binary array, without nulls.
+ */
+template <typename O>
+std::vector<std::string> arrow_string_points(const ArrowArray& arrow_array) {
+    auto offsets = static_cast<const O*>(arrow_array.buffers[1]) +
+                   arrow_array.offset;
+    auto data = static_cast<const char*>(arrow_array.buffers[2]);
+    std::vector<std::string> points;
+    points.reserve(arrow_array.length);
+    for (int64_t i = 0; i < arrow_array.length; i++) {
+        if (arrow_is_valid(arrow_array, i)) {
+            points.emplace_back(data + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    }
+    return points;
+}
+
+/**
+ * @brief Select the points of exported Arrow array chunks on a dimension,
+ * reading the coordinates from the Arrow buffers. The chunks are partitioned
+ * as one array, so each process selects one contiguous part of all points.
+ */
+void set_dim_points_arrow(
+    SOMAArray& array,
+    const std::string& dim,
+    const ArrowSchema& arrow_schema,
+    const std::vector<ArrowArray>& arrow_chunks,
+    int partition_index,
+    int partition_count) {
+    if (partition_index >= partition_count) {
+        TPY_ERROR_LOC(
+            "[pytiledbsoma] set_dim_points: partition_index (" +
+            std::to_string(partition_index) + ") must be < partition_count (" +
+            std::to_string(partition_count) + ")");
+    }
+
+    auto set_points = [&](auto& chunk_points) {
+        size_t num_points = 0;
+        for (auto& points : chunk_points) {
+            num_points += points.size();
+        }
+
+        // This partition's points, with the last partition covering the rest
+        size_t start = 0;
+        size_t end = num_points;
+        if (partition_count > 1) {
+            auto partition_size = num_points / partition_count;
+            start = partition_index * partition_size;
+            if (partition_index < partition_count - 1) {
+                end = start + partition_size;
+            }
+        }
+
+        // An empty partition still selects no points on the dimension
+        if (start == end) {
+            using Points =
+                typename std::decay_t<decltype(chunk_points)>::value_type;
+            array.set_dim_points(dim, Points(), 0, 1);
+            return;
+        }
+
+        // Select the part of each chunk in the partition, skipping the
+        // chunks outside of it and empty chunks
+        size_t offset = 0;
+        for (auto& points : chunk_points) {
+            auto first = std::max(start, offset);
+            auto last = std::min(end, offset + points.size());
+            if (first < last) {
+                array.set_dim_points(
+                    dim, points.subspan(first - offset, last - first), 0, 1);
+            }
+            offset += points.size();
+        }
+    };
+    auto set_fixed_width_points = [&](auto type) {
+        using T = decltype(type);
+        std::vector<std::vector<T>> copies(arrow_chunks.size());
+        std::vector<tcb::span<T>> chunk_points;
+        for (size_t i = 0; i < arrow_chunks.size(); i++) {
+            chunk_points.push_back(arrow_points<T>(arrow_chunks[i], copies[i]));
+        }
+        set_points(chunk_points);
+    };
+    auto set_string_points = [&](auto offset_type) {
+        using O = decltype(offset_type);
+        std::vector<std::vector<std::string>> strings;
+        std::vector<tcb::span<std::string>> chunk_points;
+        for (auto& arrow_array : arrow_chunks) {
+            auto& points = strings.emplace_back(
+                arrow_string_points<O>(arrow_array));
+            chunk_points.emplace_back(points.data(), points.size());
+        }
+        set_points(chunk_points);
+    };
+
+    std::string_view format(arrow_schema.format);
+    if (format == "l") {
+        set_fixed_width_points(int64_t{});
+    } else if (format == "i") {
+        set_fixed_width_points(int32_t{});
+    } else if (format == "s") {
+        set_fixed_width_points(int16_t{});
+    } else if (format == "c") {
+        set_fixed_width_points(int8_t{});
+    } else if (format == "L") {
+        set_fixed_width_points(uint64_t{});
+    } else if (format == "I") {
+        set_fixed_width_points(uint32_t{});
+    } else if (format == "S") {
+        set_fixed_width_points(uint16_t{});
+    } else if (format == "C") {
+        set_fixed_width_points(uint8_t{});
+    } else if (format == "f") {
+        set_fixed_width_points(float{});
+    } else if (format == "g") {
+        set_fixed_width_points(double{});
+    } else if (format == "u" || format == "z") {
+        set_string_points(uint32_t{});
+    } else if (format == "U" || format == "Z") {
+        set_string_points(uint64_t{});
+    } else if (
+        format.substr(0, 4) == "tss:" || format.substr(0, 4) == "tsm:" ||
+        format.substr(0, 4) == "tsu:" || format.substr(0, 4) == "tsn:") {
+        // Timestamps are stored as int64 in the buffer and on the dimension
+        set_fixed_width_points(int64_t{});
+    } else {
+        TPY_ERROR_LOC(
+            "[pytiledbsoma] set_dim_points: type=" + std::string(format) +
+            " not supported");
+    }
+}
+
 void load_soma_array(py::module& m) {
-    py::class_<SOMAArray>(m, "SOMAArray", "SOMAObject")
+    py::class_<SOMAArray, std::shared_ptr<SOMAArray>>(
+        m, "SOMAArray", "SOMAObject")
         .def(
             py::init(
                 [](std::string_view uri,
@@ -99,6 +269,7 @@ void load_soma_array(py::module& m) {
                         column_names = *column_names_in;
                     }
 
+                    py::gil_scoped_release release;
                     return SOMAArray::open(
                         OpenMode::read,
                         uri,
@@ -124,7 +295,10 @@ void load_soma_array(py::module& m) {
             [](SOMAArray& array,
                py::object exc_type,
                py::object exc_value,
-               py::object traceback) { array.close(); })
+               py::object traceback) {
+                py::gil_scoped_release release;
+                array.close();
+            })
 
         .def(
             "set_condition",
@@ -195,8 +369,12 @@ void load_soma_array(py::module& m) {
             "reopen",
             py::overload_cast<
                 OpenMode,
-                std::optional<std::pair<uint64_t, uint64_t>>>(&SOMAArray::open))
-        .def("close", &SOMAArray::close)
+                std::optional<std::pair<uint64_t, uint64_t>>>(&SOMAArray::open),
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "close",
+            &SOMAArray::close,
+            py::call_guard<py::gil_scoped_release>())
         .def_property_readonly(
             "closed",
             [](SOMAArray& array) -> bool { return not array.is_open(); })
@@ -215,6 +393,12 @@ void load_soma_array(py::module& m) {
                     py::capsule(array.arrow_schema().get()));
             })
         .def("context", &SOMAArray::ctx)
+        .def("set_point_selection", &SOMAArray::set_point_selection)
+        .def(
+            "set_read_partitions",
+            &SOMAArray::set_read_partitions,
+            "num_partitions"_a,
+            "preserve_order"_a = false)
 
         // After this are short functions expected to be invoked when the coords
         // are Python list/tuple, or NumPy arrays.  Arrow arrays are in this
@@ -235,83 +419,53 @@ void load_soma_array(py::module& m) {
                     array_chunks.append(py_arrow_array);
                 }
 
-                for (const pybind11::handle array_handle : array_chunks) {
-                    ArrowSchema arrow_schema;
-                    ArrowArray arrow_array;
-                    uintptr_t arrow_schema_ptr = (uintptr_t)(&arrow_schema);
-                    uintptr_t arrow_array_ptr = (uintptr_t)(&arrow_array);
-
-                    // Call handle._export_to_c to get arrow array and schema
-                    //
-                    // If ever a NumPy array gets in here, there will be an
-                    // exception like "AttributeError: 'numpy.ndarray' object
-                    // has no attribute '_export_to_c'".
-                    array_handle.attr("_export_to_c")(
-                        arrow_array_ptr, arrow_schema_ptr);
-
-                    auto coords = array_handle.attr("tolist")();
-
-                    if (!strcmp(arrow_schema.format, "l")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<int64_t>>());
-                    } else if (!strcmp(arrow_schema.format, "i")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<int32_t>>());
-                    } else if (!strcmp(arrow_schema.format, "s")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<int16_t>>());
-                    } else if (!strcmp(arrow_schema.format, "c")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<int8_t>>());
-                    } else if (!strcmp(arrow_schema.format, "L")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<uint64_t>>());
-                    } else if (!strcmp(arrow_schema.format, "I")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<uint32_t>>());
-                    } else if (!strcmp(arrow_schema.format, "S")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<uint16_t>>());
-                    } else if (!strcmp(arrow_schema.format, "C")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<uint8_t>>());
-                    } else if (!strcmp(arrow_schema.format, "f")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<float>>());
-                    } else if (!strcmp(arrow_schema.format, "g")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<double>>());
-                    } else if (
-                        !strcmp(arrow_schema.format, "u") ||
-                        !strcmp(arrow_schema.format, "z")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<std::string>>());
-                    } else if (
-                        !strcmp(arrow_schema.format, "tss:") ||
-                        !strcmp(arrow_schema.format, "tsm:") ||
-                        !strcmp(arrow_schema.format, "tsu:") ||
-                        !strcmp(arrow_schema.format, "tsn:")) {
-                        // convert the Arrow Array to int64
-                        auto pa = py::module::import("pyarrow");
-                        coords = array_handle.attr("cast")(pa.attr("int64")())
-                                     .attr("tolist")();
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<int64_t>>());
-                    } else if (
-                        !strcmp(arrow_schema.format, "U") ||
-                        !strcmp(arrow_schema.format, "Z")) {
-                        array.set_dim_points(
-                            dim, coords.cast<std::vector<std::string>>());
-                    } else {
-                        TPY_ERROR_LOC(
-                            "[pytiledbsoma] set_dim_points: type={} not "
-                            "supported" +
-                            std::string(arrow_schema.format));
+                // Export every chunk, keeping the schema of the first one:
+                // the chunks of a ChunkedArray share their type
+                std::vector<ArrowSchema> arrow_schemas(array_chunks.size());
+                std::vector<ArrowArray> arrow_chunks(array_chunks.size());
+                size_t num_exported = 0;
+                auto release = [&]() {
+                    for (size_t i = 0; i < num_exported; i++) {
+                        arrow_schemas[i].release(&arrow_schemas[i]);
+                        arrow_chunks[i].release(&arrow_chunks[i]);
+                    }
+                };
+                try {
+                    for (const pybind11::handle array_handle : array_chunks) {
+                        uintptr_t arrow_schema_ptr =
+                            (uintptr_t)(&arrow_schemas[num_exported]);
+                        uintptr_t arrow_array_ptr =
+                            (uintptr_t)(&arrow_chunks[num_exported]);
+
+                        // Call handle._export_to_c to get arrow array and
+                        // schema
+                        //
+                        // If ever a NumPy array gets in here, there will be an
+                        // exception like "AttributeError: 'numpy.ndarray'
+                        // object has no attribute '_export_to_c'".
+                        array_handle.attr("_export_to_c")(
+                            arrow_array_ptr, arrow_schema_ptr);
+                        num_exported++;
                     }
 
-                    // Release arrow schema
-                    arrow_schema.release(&arrow_schema);
+                    // Select this process's partition of all the points,
+                    // read in place from the Arrow buffers
+                    if (!arrow_chunks.empty()) {
+                        set_dim_points_arrow(
+                            array,
+                            dim,
+                            arrow_schemas[0],
+                            arrow_chunks,
+                            partition_index,
+                            partition_count);
+                    }
+                } catch (...) {
+                    release();
+                    throw;
                 }
+
+                // Release arrow schemas and arrays
+                release();
             },
             "dim"_a,
             "py_arrow_array"_a,
@@ -497,33 +651,127 @@ void load_soma_array(py::module& m) {
 
         .def("results_complete", &SOMAArray::results_complete)
 
+        // Arrow PyCapsule stream protocol: each batch is handed to the
+        // consumer as one struct array. The requested schema is ignored.
         .def(
-            "read_next",
-            [](SOMAArray& array) -> std::optional<py::object> {
-                // Release python GIL before reading data
-                py::gil_scoped_release release;
+            "__arrow_c_stream__",
+            [](py::object self, py::object requested_schema) {
+                // The stream shares ownership of the SOMAArray
+                auto array = self.cast<std::shared_ptr<SOMAArray>>();
 
-                // Try to read more data
-                auto buffers = array.read_next();
+                auto stream = static_cast<ArrowArrayStream*>(
+                    malloc(sizeof(ArrowArrayStream)));
+                if (stream == nullptr) {
+                    throw std::bad_alloc();
+                }
+                SOMAArray::to_arrow_stream(array, stream);
+                return py::capsule(
+                    stream, "arrow_array_stream", [](PyObject* capsule) {
+                        auto stream = static_cast<ArrowArrayStream*>(
+                            PyCapsule_GetPointer(
+                                capsule, "arrow_array_stream"));
+                        if (stream->release != nullptr) {
+                            stream->release(stream);
+                        }
+                        free(stream);
+                    });
+            },
+            "requested_schema"_a = py::none())
 
-                // If more data was read, convert it to an arrow table and
-                // return
-                if (buffers.has_value()) {
-                    // Acquire python GIL before accessing python objects
-                    py::gil_scoped_acquire acquire;
-                    return to_table(*buffers);
+        .def(
+            "read_next",
+            [](SOMAArray& array) -> std::optional<py::object> {
+                std::optional<ArrowTable> arrow_table;
+                {
+                    // Release python GIL while reading data and converting
+                    // it to Arrow
+                    py::gil_scoped_release release;
+
+                    // Try to read more data
+                    if (auto buffers = array.read_next()) {
+                        arrow_table = ArrowAdapter::to_arrow(*buffers);
+                    }
                 }
 
                 // No data was read, the query is complete, return nullopt
-                return std::nullopt;
+                if (!arrow_table.has_value()) {
+                    return std::nullopt;
+                }
+
+                // Import the arrow table into pyarrow with the GIL held
+                return to_pyarrow_table(std::move(*arrow_table));
             })
 
         .def("write", write)
 
         .def("write_coords", write_coords)
 
+        .def(
+            "begin_global_order_write",
+            &SOMAArray::begin_global_order_write)
+
+        .def(
+            "end_global_order_write",
+            &SOMAArray::end_global_order_write,
+            py::call_guard<py::gil_scoped_release>())
+
+        .def(
+            "set_write_behind",
+            &SOMAArray::set_write_behind,
+            "flush_rows"_a,
+            "flush_bytes"_a = 0,
+            "max_queued"_a = 2,
+            py::call_guard<py::gil_scoped_release>())
+
+        .def(
+            "flush_writes",
+            &SOMAArray::flush_writes,
+            py::call_guard<py::gil_scoped_release>())
+
         .def("nnz", &SOMAArray::nnz, py::call_guard<py::gil_scoped_release>())
 
+        .def(
+            "aggregate",
+            [](SOMAArray& array,
+               const std::string& column,
+               AggregateOp op,
+               py::object py_query_condition,
+               py::object py_schema) -> py::object {
+                std::optional<QueryCondition> qc;
+                if (!py_query_condition.is(py::none())) {
+                    // The condition is checked against the array schema
+                    // unless another one is given
+                    if (py_schema.is(py::none())) {
+                        py_schema = py::cast(array).attr("schema");
+                    }
+                    try {
+                        py_query_condition.attr("init_query_condition")(
+                            py_schema, std::vector<std::string>{column});
+                    } catch (const std::exception& e) {
+                        TPY_ERROR_LOC(e.what());
+                    }
+                    qc = *py_query_condition.attr("c_obj")
+                              .cast<PyQueryCondition>()
+                              .ptr();
+                }
+
+                std::optional<AggregateValue> result;
+                {
+                    py::gil_scoped_release release;
+                    result = array.aggregate(column, op, qc);
+                }
+                if (!result) {
+                    return py::none();
+                }
+                return std::visit(
+                    [](auto value) -> py::object { return py::cast(value); },
+                    *result);
+            },
+            "column"_a,
+            "op"_a,
+            "py_query_condition"_a = py::none(),
+            "py_schema"_a = py::none())
+
         .def_property_readonly("shape", &SOMAArray::shape)
 
         .def_property_readonly("uri", &SOMAArray::uri)
@@ -636,7 +884,10 @@ void load_soma_array(py::module& m) {
 
         .def_property_readonly("dimension_names", &SOMAArray::dimension_names)
 
-        .def("consolidate_and_vacuum", &SOMAArray::consolidate_and_vacuum)
+        .def(
+            "consolidate_and_vacuum",
+            &SOMAArray::consolidate_and_vacuum,
+            py::call_guard<py::gil_scoped_release>())
 
         .def_property_readonly(
             "meta",
@@ -47,15 +47,20 @@ using namespace py::literals;
 using namespace tiledbsoma;
 
 void load_soma_collection(py::module& m) {
-    py::class_<SOMACollection, SOMAGroup, SOMAObject>(m, "SOMACollection")
+    py::class_<
+        SOMACollection,
+        SOMAGroup,
+        SOMAObject,
+        std::shared_ptr<SOMACollection>>(m, "SOMACollection")
         .def_static(
             "open",
-            py::overload_cast<
-                std::string_view,
-                OpenMode,
-                std::shared_ptr<SOMAContext>,
-                std::optional<std::pair<uint64_t, uint64_t>>>(
-                &SOMACollection::open),
+            shared_factory(
+                py::overload_cast<
+                    std::string_view,
+                    OpenMode,
+                    std::shared_ptr<SOMAContext>,
+                    std::optional<std::pair<uint64_t, uint64_t>>>(
+                    &SOMACollection::open)),
             "uri"_a,
             py::kw_only(),
             "mode"_a,
@@ -67,12 +72,30 @@ void load_soma_collection(py::module& m) {
                 return py::make_iterator(collection.begin(), collection.end());
             },
             py::keep_alive<0, 1>())
-        .def("get", &SOMACollection::get);
+        // Members are shared with the collection cache
+        .def(
+            "get",
+            &SOMACollection::get,
+            "key"_a,
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "open_all",
+            &SOMACollection::open_all,
+            "keys"_a = std::vector<std::string>(),
+            py::call_guard<py::gil_scoped_release>());
 
-    py::class_<SOMAExperiment, SOMACollection, SOMAGroup, SOMAObject>(
-        m, "SOMAExperiment");
+    py::class_<
+        SOMAExperiment,
+        SOMACollection,
+        SOMAGroup,
+        SOMAObject,
+        std::shared_ptr<SOMAExperiment>>(m, "SOMAExperiment");
 
-    py::class_<SOMAMeasurement, SOMACollection, SOMAGroup, SOMAObject>(
-        m, "SOMAMeasurement");
+    py::class_<
+        SOMAMeasurement,
+        SOMACollection,
+        SOMAGroup,
+        SOMAObject,
+        std::shared_ptr<SOMAMeasurement>>(m, "SOMAMeasurement");
 }
 }  // namespace libtiledbsomacpp
@@ -51,6 +51,12 @@ void load_soma_context(py::module& m) {
     py::class_<SOMAContext, std::shared_ptr<SOMAContext>>(m, "SOMAContext")
         .def(py::init<>())
         .def(py::init<std::map<std::string, std::string>>())
-        .def("config", &SOMAContext::tiledb_config);
+        .def("config", &SOMAContext::tiledb_config)
+        .def_static(
+            "cached",
+            &SOMAContext::cached,
+            "config"_a = std::map<std::string, std::string>(),
+            py::call_guard<py::gil_scoped_release>())
+        .def_static("clear_cache", &SOMAContext::clear_cache);
 };
 }  // namespace libtiledbsomacpp
@@ -47,7 +47,11 @@ using namespace py::literals;
 using namespace tiledbsoma;
 
 void load_soma_dataframe(py::module& m) {
-    py::class_<SOMADataFrame, SOMAArray, SOMAObject>(m, "SOMADataFrame")
+    py::class_<
+        SOMADataFrame,
+        SOMAArray,
+        SOMAObject,
+        std::shared_ptr<SOMADataFrame>>(m, "SOMADataFrame")
 
         .def_static(
             "create",
@@ -117,14 +121,15 @@ void load_soma_dataframe(py::module& m) {
 
         .def_static(
             "open",
-            py::overload_cast<
-                std::string_view,
-                OpenMode,
-                std::shared_ptr<SOMAContext>,
-                std::vector<std::string>,
-                ResultOrder,
-                std::optional<std::pair<uint64_t, uint64_t>>>(
-                &SOMADataFrame::open),
+            shared_factory(
+                py::overload_cast<
+                    std::string_view,
+                    OpenMode,
+                    std::shared_ptr<SOMAContext>,
+                    std::vector<std::string>,
+                    ResultOrder,
+                    std::optional<std::pair<uint64_t, uint64_t>>>(
+                    &SOMADataFrame::open)),
             "uri"_a,
             "mode"_a,
             "context"_a,
@@ -51,6 +51,7 @@ void write(SOMAArray& array, py::array data) {
     array.set_column_data("soma_data", data.size(), (const void*)data_info.ptr);
 
     try {
+        py::gil_scoped_release release;
         array.write();
     } catch (const std::exception& e) {
         TPY_ERROR_LOC(e.what());
@@ -58,7 +59,11 @@ void write(SOMAArray& array, py::array data) {
 }
 
 void load_soma_dense_ndarray(py::module& m) {
-    py::class_<SOMADenseNDArray, SOMAArray, SOMAObject>(m, "SOMADenseNDArray")
+    py::class_<
+        SOMADenseNDArray,
+        SOMAArray,
+        SOMAObject,
+        std::shared_ptr<SOMADenseNDArray>>(m, "SOMADenseNDArray")
 
         .def_static(
             "create",
@@ -106,14 +111,15 @@ void load_soma_dense_ndarray(py::module& m) {
 
         .def_static(
             "open",
-            py::overload_cast<
-                std::string_view,
-                OpenMode,
-                std::shared_ptr<SOMAContext>,
-                std::vector<std::string>,
-                ResultOrder,
-                std::optional<std::pair<uint64_t, uint64_t>>>(
-                &SOMADenseNDArray::open),
+            shared_factory(
+                py::overload_cast<
+                    std::string_view,
+                    OpenMode,
+                    std::shared_ptr<SOMAContext>,
+                    std::vector<std::string>,
+                    ResultOrder,
+                    std::optional<std::pair<uint64_t, uint64_t>>>(
+                    &SOMADenseNDArray::open)),
             "uri"_a,
             "mode"_a,
             "context"_a,
@@ -39,7 +39,8 @@ using namespace py::literals;
 using namespace tiledbsoma;
 
 void load_soma_group(py::module& m) {
-    py::class_<SOMAGroup, SOMAObject>(m, "SOMAGroup")
+    py::class_<SOMAGroup, SOMAObject, std::shared_ptr<SOMAGroup>>(
+        m, "SOMAGroup")
         .def_static(
             "create",
             [](std::shared_ptr<SOMAContext> ctx,
@@ -48,7 +48,7 @@ using namespace py::literals;
 using namespace tiledbsoma;
 
 void load_soma_object(py::module& m) {
-    py::class_<SOMAObject>(m, "SOMAObject")
+    py::class_<SOMAObject, std::shared_ptr<SOMAObject>>(m, "SOMAObject")
 
         .def_static(
             "open",
@@ -36,6 +36,7 @@
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 
+#include <tiledbsoma/reindexer/reindexer.h>
 #include <tiledbsoma/tiledbsoma>
 
 #include "common.h"
@@ -47,7 +48,11 @@ using namespace py::literals;
 using namespace tiledbsoma;
 
 void load_soma_sparse_ndarray(py::module& m) {
-    py::class_<SOMASparseNDArray, SOMAArray, SOMAObject>(m, "SOMASparseNDArray")
+    py::class_<
+        SOMASparseNDArray,
+        SOMAArray,
+        SOMAObject,
+        std::shared_ptr<SOMASparseNDArray>>(m, "SOMASparseNDArray")
 
         .def_static(
             "create",
@@ -94,14 +99,15 @@ void load_soma_sparse_ndarray(py::module& m) {
 
         .def_static(
             "open",
-            py::overload_cast<
-                std::string_view,
-                OpenMode,
-                std::shared_ptr<SOMAContext>,
-                std::vector<std::string>,
-                ResultOrder,
-                std::optional<std::pair<uint64_t, uint64_t>>>(
-                &SOMASparseNDArray::open),
+            shared_factory(
+                py::overload_cast<
+                    std::string_view,
+                    OpenMode,
+                    std::shared_ptr<SOMAContext>,
+                    std::vector<std::string>,
+                    ResultOrder,
+                    std::optional<std::pair<uint64_t, uint64_t>>>(
+                    &SOMASparseNDArray::open)),
             "uri"_a,
             "mode"_a,
             "context"_a,
@@ -110,6 +116,99 @@ void load_soma_sparse_ndarray(py::module& m) {
             "result_order"_a = ResultOrder::automatic,
             "timestamp"_a = py::none())
 
-        .def_static("exists", &SOMASparseNDArray::exists);
+        .def_static("exists", &SOMASparseNDArray::exists)
+
+        .def(
+            "reduce_axis",
+            [](SOMASparseNDArray& array, uint64_t axis) {
+                std::shared_ptr<ArrayBuffers> buffers;
+                {
+                    py::gil_scoped_release release;
+                    buffers = array.reduce_axis(axis);
+                }
+                return to_table(buffers);
+            },
+            "axis"_a);
+
+    // Builds CSR/CSC matrices from COO batches. The indptr, indices and data
+    // arrays are NumPy views of the C++ buffers, which are kept alive by the
+    // views.
+    py::class_<CompressedSparseMatrix, std::shared_ptr<CompressedSparseMatrix>>(
+        m, "CompressedSparseMatrix")
+        .def(
+            py::init([](std::shared_ptr<SOMAContext> context,
+                        uint64_t num_rows,
+                        uint64_t num_cols,
+                        bool csr,
+                        IntIndexer* row_indexer,
+                        IntIndexer* col_indexer) {
+                // The indexers are owned by Python and kept alive below
+                auto borrow = [](IntIndexer* indexer) {
+                    return indexer == nullptr ?
+                               nullptr :
+                               std::shared_ptr<IntIndexer>(
+                                   indexer, [](IntIndexer*) {});
+                };
+                return std::make_shared<CompressedSparseMatrix>(
+                    context,
+                    num_rows,
+                    num_cols,
+                    csr,
+                    borrow(row_indexer),
+                    borrow(col_indexer));
+            }),
+            "context"_a,
+            "num_rows"_a,
+            "num_cols"_a,
+            py::kw_only(),
+            "csr"_a = true,
+            "row_indexer"_a = nullptr,
+            "col_indexer"_a = nullptr,
+            py::keep_alive<1, 6>(),
+            py::keep_alive<1, 7>())
+
+        .def(
+            "append_reads",
+            [](CompressedSparseMatrix& matrix, SOMAArray& array) {
+                py::gil_scoped_release release;
+                while (auto batch = array.read_next()) {
+                    matrix.append(*batch);
+                }
+            },
+            "array"_a)
+
+        .def(
+            "compress",
+            &CompressedSparseMatrix::compress,
+            py::call_guard<py::gil_scoped_release>())
+
+        .def_property_readonly("nnz", &CompressedSparseMatrix::nnz)
+
+        .def(
+            "indptr",
+            [](py::object self) {
+                auto& indptr = self.cast<CompressedSparseMatrix&>().indptr();
+                return py::array_t<int64_t>(
+                    indptr.size(), indptr.data(), self);
+            })
+
+        .def(
+            "indices",
+            [](py::object self) {
+                auto& indices = self.cast<CompressedSparseMatrix&>().indices();
+                return py::array_t<int64_t>(
+                    indices.size(), indices.data(), self);
+            })
+
+        .def("data", [](py::object self) {
+            auto& matrix = self.cast<CompressedSparseMatrix&>();
+            auto dtype = tdb_to_np_dtype(matrix.data_type(), 1);
+            return py::array(
+                dtype,
+                {static_cast<py::ssize_t>(matrix.nnz())},
+                {static_cast<py::ssize_t>(dtype.itemsize())},
+                matrix.data().data(),
+                self);
+        });
 }
 }  // namespace libtiledbsomacpp
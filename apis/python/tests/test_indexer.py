@@ -113,3 +113,53 @@ def test_indexer(contextual: bool, keys: np.array, lookups: np.array):
     panda_results = panda_indexer.get_indexer(lookups)
     for i in range(num_threads):
         np.testing.assert_equal(all_results[i].all(), panda_results.all())
+
+
+@pytest.mark.parametrize(
+    "keys, lookups",
+    [
+        (np.array([5, -3, 7], dtype=np.int32), np.array([7, 5, 1], dtype=np.int32)),
+        (
+            np.array([4000000000, 3, 9], dtype=np.uint32),
+            np.array([9, 4000000000, 2], dtype=np.uint32),
+        ),
+        (
+            np.array([2**63 + 1, 3, 9], dtype=np.uint64),
+            np.array([9, 2**63 + 1, 2], dtype=np.uint64),
+        ),
+        (
+            pa.array([5, -3, 7], type=pa.int8()),
+            pa.array([7, 5, 1], type=pa.int8()),
+        ),
+        (
+            pa.array([200, 3, 9], type=pa.uint8()),
+            pa.array([9, 200, 2], type=pa.uint8()),
+        ),
+        (
+            pa.array([-30000, 3, 9], type=pa.int16()),
+            pa.array([9, -30000, 2], type=pa.int16()),
+        ),
+        (
+            pa.chunked_array([[60000, 3], [9]], type=pa.uint16()),
+            pa.array([9, 60000, 2], type=pa.uint16()),
+        ),
+        (["AAAC-1", "AAAG-1", "AATC-1"], ["AATC-1", "TTTT-1", "AAAC-1"]),
+        (
+            pa.chunked_array([["AAAC-1", "AAAG-1"], ["AATC-1"]]),
+            pa.array(["AATC-1", "TTTT-1", "AAAC-1"], type=pa.large_string()),
+        ),
+        (
+            pd.Series(["AAAC-1", "AAAG-1", "AATC-1"]),
+            np.array(["AATC-1", "TTTT-1", "AAAC-1"], dtype=object),
+        ),
+    ],
+)
+def test_indexer_key_types(keys, lookups):
+    context = _validate_soma_tiledb_context(SOMATileDBContext())
+    indexer = IntIndexer(keys, context=context)
+    results = indexer.get_indexer(lookups)
+
+    keys = keys.to_pylist() if isinstance(keys, (pa.Array, pa.ChunkedArray)) else keys
+    lookups = lookups.to_pylist() if isinstance(lookups, pa.Array) else lookups
+    expected = pd.Index(keys).get_indexer(lookups)
+    np.testing.assert_array_equal(results, expected)
@@ -224,5 +224,19 @@ def test_eval_error_conditions(malformed_condition):
         qc.init_query_condition(sr.schema, ["bad_query_attr"])
 
 
+@pytest.mark.parametrize("with_schema", [True, False])
+def test_aggregate_with_condition(with_schema):
+    uri = os.path.join(SOMA_URI, "obs")
+    expected = pandas_query(uri, "n_genes > 500")
+
+    sr = clib.SOMAArray(uri)
+    qc = QueryCondition("n_genes > 500")
+    schema = sr.schema if with_schema else None
+    count = sr.aggregate("n_genes", clib.AggregateOp.count, qc, schema)
+    assert count == len(expected)
+    total = sr.aggregate("n_genes", clib.AggregateOp.sum, qc, schema)
+    assert total == expected["n_genes"].sum()
+
+
 if __name__ == "__main__":
     test_query_condition_select_columns()
@@ -134,6 +134,29 @@ def test_soma_array_dim_points_arrow_array():
     assert arrow_table.num_rows == len(obs_id_points)
 
 
+def test_soma_array_dim_points_arrow_chunked_partitions():
+    """Partition the points of a chunked array as one concatenated array."""
+
+    name = "obs"
+    uri = os.path.join(SOMA_URI, name)
+    obs_id_points = pa.chunked_array([[0, 2, 4], [], [6], [8, 10, 12, 14]])
+
+    joinids = []
+    for partition_index in range(3):
+        sr = clib.SOMAArray(uri, column_names=["soma_joinid"])
+        sr.set_dim_points_arrow(
+            "soma_joinid",
+            obs_id_points,
+            partition_index=partition_index,
+            partition_count=3,
+        )
+        arrow_table = sr.read_next()
+        assert sr.results_complete()
+        joinids.append(arrow_table["soma_joinid"].to_pylist())
+
+    assert joinids == [[0, 2], [4, 6], [8, 10, 12, 14]]
+
+
 def test_soma_array_dim_ranges():
     """Read range dimension slice from obs array into an arrow table."""
 
@@ -1832,3 +1832,139 @@ def test_global_writes(tmp_path):
             )
         assert "The write parameter now takes in TileDBWriteOptions instead "
         "of TileDBCreateOptions" == warning[0].message
+
+
+def test_read_arrow_coords(tmp_path):
+    uri = tmp_path.as_posix()
+    soma.SparseNDArray.create(uri, type=pa.int32(), shape=(10,))
+    with soma.SparseNDArray.open(uri, "w") as A:
+        A.write(
+            pa.Table.from_pydict(
+                {
+                    "soma_dim_0": pa.array(range(10), type=pa.int64()),
+                    "soma_data": pa.array(range(10), type=pa.int32()),
+                }
+            )
+        )
+
+    # Sliced, chunked and null coordinates are read from the Arrow buffers
+    sliced = pa.array([0, 1, 2, 3, 4, 5], type=pa.int64()).slice(3, 2)
+    chunked = pa.chunked_array([[7], [9]], type=pa.int64())
+    with_nulls = pa.array([8, None, 6], type=pa.int64())
+    with soma.SparseNDArray.open(uri) as A:
+        for coords, expected in [
+            (sliced, [3, 4]),
+            (chunked, [7, 9]),
+            (with_nulls, [6, 8]),
+        ]:
+            table = A.read((coords,)).tables().concat()
+            assert sorted(table["soma_data"].to_pylist()) == expected
+
+
+def test_arrow_c_stream(tmp_path):
+    uri = tmp_path.as_posix()
+    soma.SparseNDArray.create(uri, type=pa.int32(), shape=(10,))
+    with soma.SparseNDArray.open(uri, "w") as A:
+        A.write(
+            pa.Table.from_pydict(
+                {
+                    "soma_dim_0": pa.array(range(10), type=pa.int64()),
+                    "soma_data": pa.array(range(10), type=pa.int32()),
+                }
+            )
+        )
+
+    if not hasattr(pa.RecordBatchReader, "from_stream"):
+        pytest.skip("pyarrow does not support the Arrow PyCapsule interface")
+
+    sr = soma.pytiledbsoma.SOMAArray(uri, batch_size="40")
+    reader = pa.RecordBatchReader.from_stream(sr)
+    assert reader.schema.names == ["soma_dim_0", "soma_data"]
+
+    table = reader.read_all()
+    assert table.num_rows == 10
+    assert table["soma_data"].to_pylist() == list(range(10))
+
+
+@pytest.mark.parametrize("csr", [True, False])
+def test_compressed_sparse_matrix(tmp_path: pathlib.Path, csr: bool) -> None:
+    uri = tmp_path.as_posix()
+    soma.SparseNDArray.create(uri, type=pa.float32(), shape=(3, 4))
+    with soma.SparseNDArray.open(uri, "w") as A:
+        A.write(
+            pa.Table.from_pydict(
+                {
+                    "soma_dim_0": pa.array([2, 0, 0, 1, 2], pa.int64()),
+                    "soma_dim_1": pa.array([1, 3, 0, 2, 0], pa.int64()),
+                    "soma_data": pa.array([1, 2, 3, 4, 5], pa.float32()),
+                }
+            )
+        )
+
+    context = SOMATileDBContext()
+    matrix = soma.pytiledbsoma.CompressedSparseMatrix(
+        context.native_context, 3, 4, csr=csr
+    )
+    matrix.append_reads(soma.pytiledbsoma.SOMAArray(uri))
+
+    # The arrays are not available until compressed
+    with pytest.raises(soma.SOMAError):
+        matrix.indptr()
+    matrix.compress()
+
+    assert matrix.nnz == 5
+    cls = sparse.csr_matrix if csr else sparse.csc_matrix
+    sp = cls((matrix.data(), matrix.indices(), matrix.indptr()), shape=(3, 4))
+    assert sp.has_sorted_indices
+    expected = np.array([[3, 0, 0, 2], [0, 0, 4, 0], [5, 1, 0, 0]], np.float32)
+    assert np.array_equal(sp.toarray(), expected)
+
+
+def test_reduce_axis(tmp_path: pathlib.Path) -> None:
+    uri = tmp_path.as_posix()
+    soma.SparseNDArray.create(uri, type=pa.float64(), shape=(4, 3))
+    with soma.SparseNDArray.open(uri, "w") as A:
+        A.write(
+            pa.Table.from_pydict(
+                {
+                    "soma_dim_0": pa.array([0, 0, 2, 3], pa.int64()),
+                    "soma_dim_1": pa.array([0, 2, 1, 0], pa.int64()),
+                    "soma_data": pa.array([1, 2, 3, -4], pa.float64()),
+                }
+            )
+        )
+
+    context = SOMATileDBContext()
+    expected = {
+        0: {
+            "soma_joinid": [0, 1, 2, 3],
+            "nnz": [2, 0, 1, 1],
+            "sum": [3, 0, 3, -4],
+            "sum_sq": [5, 0, 9, 16],
+            "min": [1, None, 3, -4],
+            "max": [2, None, 3, -4],
+        },
+        1: {
+            "soma_joinid": [0, 1, 2],
+            "nnz": [2, 1, 1],
+            "sum": [-3, 3, 2],
+            "sum_sq": [17, 9, 4],
+            "min": [-4, 3, 2],
+            "max": [1, 3, 2],
+        },
+    }
+    for axis, columns in expected.items():
+        array = soma.pytiledbsoma.SOMASparseNDArray.open(
+            uri, soma.pytiledbsoma.OpenMode.read, context.native_context
+        )
+        table = array.reduce_axis(axis)
+        array.close()
+        for name, values in columns.items():
+            assert table.column(name).to_pylist() == values
+
+    array = soma.pytiledbsoma.SOMASparseNDArray.open(
+        uri, soma.pytiledbsoma.OpenMode.read, context.native_context
+    )
+    with pytest.raises(soma.SOMAError):
+        array.reduce_axis(2)
+    array.close()
@@ -89,9 +89,9 @@ Rcpp::List sr_setup(const std::string& uri,
 
 
     std::map<std::string, std::string> platform_config = config_vector_to_map(Rcpp::wrap(config));
-    tiledb::Config cfg(platform_config);
-    spdl::debug("[sr_setup] creating ctx object with supplied config");
-    std::shared_ptr<tiledb::Context> ctxptr = std::make_shared<tiledb::Context>(cfg);
+    spdl::debug("[sr_setup] getting cached ctx object for supplied config");
+    std::shared_ptr<tdbs::SOMAContext> somactx = tdbs::SOMAContext::cached(platform_config);
+    std::shared_ptr<tiledb::Context> ctxptr = somactx->tiledb_ctx();
 
     ctx_wrap_t* ctxwrap_p = new ContextWrapper(ctxptr);
     Rcpp::XPtr<ctx_wrap_t> ctx_wrap_xptr = make_xptr<ctx_wrap_t>(ctxwrap_p, false);
@@ -109,7 +109,7 @@ Rcpp::List sr_setup(const std::string& uri,
 
     auto tdb_result_order = get_tdb_result_order(result_order);
 
-    auto ptr = new tdbs::SOMAArray(OpenMode::read, uri, name, platform_config,
+    auto ptr = new tdbs::SOMAArray(OpenMode::read, uri, somactx, name,
                                    column_names, batch_size,
                                    tdb_result_order, std::make_pair(ts_start, ts_end));
 
@@ -207,40 +207,16 @@ SEXP sr_next(Rcpp::XPtr<tdbs::SOMAArray> sr) {
    spdl::debug("[sr_next] Read {} rows and {} cols",
                sr_data->get()->num_rows(), sr_data->get()->names().size());
 
-   const std::vector<std::string> names = sr_data->get()->names();
-   auto ncol = names.size();
-   // Schema first
+   // all columns at once as a struct array and its schema
+   auto pp = tdbs::ArrowAdapter::to_arrow(sr_data.value());
+
    auto schemaxp = nanoarrow_schema_owning_xptr();
    auto sch = nanoarrow_output_schema_from_xptr(schemaxp);
-   exitIfError(ArrowSchemaInitFromType(sch, NANOARROW_TYPE_STRUCT), "Bad schema init");
-   exitIfError(ArrowSchemaSetName(sch, ""), "Bad schema name");
-   exitIfError(ArrowSchemaAllocateChildren(sch, ncol), "Bad schema children alloc");
+   ArrowSchemaMove(pp.second.get(), sch);
 
-   // Array second
    auto arrayxp = nanoarrow_array_owning_xptr();
    auto arr = nanoarrow_output_array_from_xptr(arrayxp);
-   exitIfError(ArrowArrayInitFromType(arr, NANOARROW_TYPE_STRUCT), "Bad array init");
-   exitIfError(ArrowArrayAllocateChildren(arr, ncol), "Bad array children alloc");
-
-   arr->length = 0;             // initial value
-
-   for (size_t i=0; i<ncol; i++) {
-       spdl::trace("[sr_next] Accessing {} at {}", names[i], i);
-
-       // now buf is a shared_ptr to ColumnBuffer
-       auto buf = sr_data->get()->at(names[i]);
-
-       // this is pair of array and schema pointer
-       auto pp = tdbs::ArrowAdapter::to_arrow(buf);
-
-       ArrowArrayMove(pp.first.get(),   arr->children[i]);
-       ArrowSchemaMove(pp.second.get(), sch->children[i]);
-
-       if (pp.first->length > arr->length) {
-           spdl::debug("[soma_array_reader] Setting array length to {}", pp.first->length);
-           arr->length = pp.first->length;
-       }
-   }
+   ArrowArrayMove(pp.first.get(), arr);
 
    spdl::debug("[sr_next] Exporting chunk with {} rows", arr->length);
    // Nanoarrow special: stick schema into xptr tag to return single SEXP
@@ -28,16 +28,27 @@
  * @section DESCRIPTION
  *
  * This file declares the ThreadPool class.
+ *
+ * Each worker thread owns a task deque. Tasks scheduled from a worker are
+ * pushed to its own deque and popped back in LIFO order, tasks scheduled from
+ * other threads are distributed round-robin, and an idle worker steals the
+ * oldest task of another worker's deque.
  */
 
 #ifndef TILEDB_THREAD_POOL_H
 #define TILEDB_THREAD_POOL_H
 
-#include "producer_consumer_queue.h"
 #include "status.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <tiledb/tiledb>
 
@@ -107,7 +118,7 @@ class ThreadPool {
 
     std::future<R> future = task->get_future();
 
-    task_queue_.push(task);
+    enqueue(std::move(task));
 
     return future;
   }
@@ -155,17 +166,55 @@ class ThreadPool {
   /* ********************************* */
 
  private:
-  /** The worker thread routine */
-  void worker();
+  using TaskPtr = std::shared_ptr<std::packaged_task<Status()>>;
+
+  /** The task deque of a worker thread */
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<TaskPtr> tasks;
+  };
+
+  /**
+   * The worker thread routine
+   *
+   * @param index Index of the worker thread and of its task deque
+   */
+  void worker(size_t index);
 
   /** Terminate threads in the thread pool */
   void shutdown();
 
-  /** Producer-consumer queue where functions to be executed are kept */
-  ProducerConsumerQueue<
-      std::shared_ptr<std::packaged_task<Status()>>,
-      std::deque<std::shared_ptr<std::packaged_task<Status()>>>>
-      task_queue_;
+  /** Add a task to the deque of the calling worker or of the next worker */
+  void enqueue(TaskPtr task);
+
+  /**
+   * Take a task from the deque of the calling worker, or steal one from
+   * another worker.
+   *
+   * @return The task, or nullptr if all the deques are empty
+   */
+  TaskPtr try_pop();
+
+  /** The task deques, one per worker thread */
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  /** The worker deque the next task from outside the pool is added to */
+  std::atomic<size_t> next_queue_{0};
+
+  /** Number of tasks in the deques */
+  std::atomic<size_t> pending_{0};
+
+  /** Number of workers waiting for a task */
+  std::atomic<size_t> idle_{0};
+
+  /** True once the pool is shut down */
+  bool stopped_ = false;
+
+  /** Protects stopped_ and the sleep of idle workers */
+  std::mutex idle_mutex_;
+
+  /** Wakes up idle workers when a task is added or the pool shuts down */
+  std::condition_variable idle_cv_;
 
   /** The worker threads */
   std::vector<std::thread> threads_;
@@ -41,14 +41,20 @@
 
 namespace tiledbsoma {
 
+namespace {
+// The pool and deque index of the calling thread, if it is a worker thread
+thread_local const ThreadPool* worker_pool = nullptr;
+thread_local size_t worker_index = 0;
+}  // namespace
+
 // Constructor.  May throw an exception on error.  No logging is done as the
 // logger may not yet be initialized.
 ThreadPool::ThreadPool(size_t n)
     : concurrency_level_(n) {
   // If concurrency_level_ is set to zero, construct the thread pool in shutdown
-  // state.  Explicitly shut down the task queue as well.
+  // state.
   if (concurrency_level_ == 0) {
-    task_queue_.drain();
+    stopped_ = true;
     return;
   }
 
@@ -62,6 +68,11 @@ ThreadPool::ThreadPool(size_t n)
     throw std::runtime_error(msg);
   }
 
+  queues_.reserve(concurrency_level_);
+  for (size_t i = 0; i < concurrency_level_; ++i) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
   threads_.reserve(concurrency_level_);
 
   for (size_t i = 0; i < concurrency_level_; ++i) {
@@ -74,7 +85,7 @@ ThreadPool::ThreadPool(size_t n)
     size_t tries = 3;
     while (tries--) {
       try {
-        tmp = std::thread(&ThreadPool::worker, this);
+        tmp = std::thread(&ThreadPool::worker, this, i);
       } catch (const std::system_error& e) {
         if (e.code() != std::errc::resource_unavailable_try_again ||
             tries == 0) {
@@ -100,22 +111,91 @@ ThreadPool::ThreadPool(size_t n)
   }
 }
 
-void ThreadPool::worker() {
+void ThreadPool::worker(size_t index) {
+  worker_pool = this;
+  worker_index = index;
+
   while (true) {
-    auto val = task_queue_.pop();
-    if (val) {
-      (*(*val))();
-    } else {
+    if (auto task = try_pop()) {
+      (*task)();
+      continue;
+    }
+
+    // Sleep until a task is added. enqueue() only takes idle_mutex_ when a
+    // worker is idle, so idle_ is incremented before pending_ is checked.
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    ++idle_;
+    idle_cv_.wait(lock, [this] { return pending_ > 0 || stopped_; });
+    --idle_;
+    if (stopped_ && pending_ == 0) {
       break;
     }
   }
 }
 
+void ThreadPool::enqueue(TaskPtr task) {
+  // Tasks scheduled by a worker stay on its own deque, where they are likely
+  // to be run by the same thread while their data is still in cache.
+  size_t index = worker_pool == this ? worker_index :
+                                       next_queue_++ % queues_.size();
+
+  // pending_ is incremented first so that it never underflows when the task
+  // is stolen right after being pushed.
+  ++pending_;
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+
+  if (idle_ > 0) {
+    // Taking the lock orders the notification after the idle worker's
+    // check of pending_
+    { std::lock_guard<std::mutex> lock(idle_mutex_); }
+    idle_cv_.notify_one();
+  }
+}
+
+ThreadPool::TaskPtr ThreadPool::try_pop() {
+  size_t num_queues = queues_.size();
+  if (num_queues == 0 || pending_ == 0) {
+    return nullptr;
+  }
+
+  // A worker takes the newest task of its own deque, and steals the oldest
+  // task of the others. Other threads start from the first deque.
+  bool own = worker_pool == this;
+  size_t start = own ? worker_index : 0;
+  for (size_t i = 0; i < num_queues; ++i) {
+    auto& queue = *queues_[(start + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+
+    TaskPtr task;
+    if (own && i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --pending_;
+    return task;
+  }
+  return nullptr;
+}
+
 // shutdown is private and only called by constructor and destructor (RAII), so
-// shutdown won't be called from multiple threads.
+// shutdown won't be called from multiple threads. The workers run the tasks
+// left in the deques before exiting.
 void ThreadPool::shutdown() {
   concurrency_level_.store(0);
-  task_queue_.drain();
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    stopped_ = true;
+  }
+  idle_cv_.notify_all();
   for (auto&& t : threads_) {
     t.join();
   }
@@ -189,8 +269,8 @@ std::vector<Status> ThreadPool::wait_all_status(std::vector<Task>& tasks) {
 
       // In the meantime, try to do something useful to make progress (and avoid
       // deadlock)
-      if (auto val = task_queue_.try_pop()) {
-        (*(*val))();
+      if (auto val = try_pop()) {
+        (*val)();
       } else {
         // If nothing useful to do, yield so we don't burn cycles
         // going through the task list over and over (thereby slowing down other
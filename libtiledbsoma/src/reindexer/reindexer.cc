@@ -32,7 +32,10 @@
 
 #include "reindexer.h"
 #include <thread_pool/thread_pool.h>
+#include <algorithm>
+#include <bitset>
 #include <thread>
+#include <type_traits>
 #include "khash.h"
 #include "soma/enums.h"
 #include "soma/soma_context.h"
@@ -45,7 +48,34 @@ KHASH_MAP_INIT_INT64(m64, int64_t)
 
 namespace tiledbsoma {
 
-void IntIndexer::map_locations(const int64_t* keys, size_t size) {
+namespace {
+
+// Shard of a key. The shard is taken from the top bits of a multiplicative
+// hash, so that it is independent of the low bits khash uses for buckets.
+inline size_t shard_of(int64_t key, unsigned shard_bits) {
+    if (shard_bits == 0) {
+        return 0;
+    }
+    return (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >>
+           (64 - shard_bits);
+}
+
+// Insert a key with its position as value. Returns false if the key is
+// already in the table.
+inline bool insert_key(kh_m64_t* hash, int64_t key, size_t position) {
+    int ret;
+    khint64_t k = kh_put(m64, hash, key, &ret);
+    assert(k != kh_end(hash));
+    kh_val(hash, k) = position;
+    return ret != 0;
+}
+
+}  // namespace
+
+template <typename T>
+void IntIndexer::map_locations(const T* keys, size_t size) {
+    static_assert(std::is_integral_v<T>, "IntIndexer keys must be integers");
+    clear();
     map_size_ = size;
 
     // Handling edge cases
@@ -53,46 +83,242 @@ void IntIndexer::map_locations(const int64_t* keys, size_t size) {
         return;
     }
 
-    hash_ = kh_init(m64);
-    kh_resize(m64, hash_, size * 1.25);
-    int ret;
-    khint64_t k;
-    int64_t counter = 0;
-    // Hash map construction
-    LOG_DEBUG(
-        fmt::format("[Re-indexer] Start of Map locations with {} keys", size));
+    if (map_sorted(keys, size)) {
+        LOG_DEBUG(fmt::format(
+            "[Re-indexer] Mapped {} sorted keys with a {}",
+            size,
+            layout_ == Layout::range ? "range" : "bitmap"));
+        return;
+    }
+    map_integers(keys, size);
+}
+
+template <typename O>
+void IntIndexer::map_locations(
+    const char* data, const O* offsets, size_t size) {
+    clear();
+    map_size_ = size;
+
+    // Handling edge cases
+    if (size == 0) {
+        return;
+    }
+
+    // The views into the arena stay valid as it is not resized afterwards
+    string_arena_.assign(data + offsets[0], data + offsets[size]);
+    string_index_.reserve(size);
     for (size_t i = 0; i < size; i++) {
-        k = kh_put(m64, hash_, keys[i], &ret);
-        assert(k != kh_end(hash_));
-        kh_val(hash_, k) = counter;
-        counter++;
+        std::string_view key(
+            string_arena_.data() + (offsets[i] - offsets[0]),
+            offsets[i + 1] - offsets[i]);
+        if (!string_index_.emplace(key, i).second) {
+            throw std::runtime_error("There are duplicate keys.");
+        }
+    }
+    layout_ = Layout::string;
+    LOG_DEBUG(fmt::format(
+        "[Re-indexer] Mapped {} string keys of {} bytes",
+        size,
+        string_arena_.size()));
+}
+
+void IntIndexer::map_locations(const std::vector<std::string>& keys) {
+    std::vector<uint64_t> offsets(keys.size() + 1, 0);
+    for (size_t i = 0; i < keys.size(); i++) {
+        offsets[i + 1] = offsets[i] + keys[i].size();
+    }
+    std::string data;
+    data.reserve(offsets.back());
+    for (const auto& key : keys) {
+        data += key;
+    }
+    map_locations(data.data(), offsets.data(), keys.size());
+}
+
+template <typename T>
+void IntIndexer::map_integers(const T* keys, size_t size) {
+    // One shard per thread, rounded up to a power of two. Threads beyond the
+    // number of cores would only interleave the shard builds.
+    size_t concurrency = 1;
+    if (size >= MIN_PARALLEL_MAP_SIZE && context_ != nullptr &&
+        context_->thread_pool() != nullptr) {
+        concurrency = std::min<size_t>(
+            context_->thread_pool()->concurrency_level(),
+            std::max(1u, std::thread::hardware_concurrency()));
+    }
+    shard_bits_ = 0;
+    while ((size_t(1) << shard_bits_) < concurrency) {
+        shard_bits_++;
+    }
+    size_t num_shards = size_t(1) << shard_bits_;
+    shards_.resize(num_shards);
+    for (auto& shard : shards_) {
+        shard = kh_init(m64);
+        kh_resize(m64, shard, size * 1.25 / num_shards);
     }
-    if (kh_size(hash_) != size) {
+
+    // Hash map construction
+    LOG_DEBUG(fmt::format(
+        "[Re-indexer] Start of Map locations with {} keys in {} shards",
+        size,
+        num_shards));
+    bool unique = true;
+    if (num_shards == 1) {
+        for (size_t i = 0; i < size && unique; i++) {
+            unique = insert_key(shards_[0], keys[i], i);
+        }
+    } else {
+        unique = map_shards(keys, size);
+    }
+    if (!unique) {
         throw std::runtime_error("There are duplicate keys.");
     }
-    auto hsize = kh_size(hash_);
+    size_t hsize = 0;
+    for (auto shard : shards_) {
+        hsize += kh_size(shard);
+    }
     LOG_DEBUG(fmt::format("[Re-indexer] khash size = {}", hsize));
 
     LOG_DEBUG(
         fmt::format("[Re-indexer] Thread pool started and hash table created"));
 }
 
-void IntIndexer::lookup(const int64_t* keys, int64_t* results, size_t size) {
+template <typename T>
+bool IntIndexer::map_shards(const T* keys, size_t size) {
+    auto& thread_pool = context_->thread_pool();
+    size_t num_shards = shards_.size();
+    size_t num_chunks = thread_pool->concurrency_level();
+    size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+
+    // Run fn(i) for i in [0, n) on the thread pool
+    auto parallel_for = [&thread_pool](size_t n, auto fn) {
+        std::vector<ThreadPool::Task> tasks;
+        for (size_t i = 0; i < n; i++) {
+            tasks.emplace_back(thread_pool->execute([i, &fn]() {
+                fn(i);
+                return Status::Ok();
+            }));
+        }
+        thread_pool->wait_all(tasks);
+    };
+
+    // Count the keys of each chunk in each shard
+    std::vector<size_t> counts(num_chunks * num_shards, 0);
+    parallel_for(num_chunks, [&](size_t chunk) {
+        size_t* chunk_counts = &counts[chunk * num_shards];
+        size_t end = std::min(size, (chunk + 1) * chunk_size);
+        for (size_t i = chunk * chunk_size; i < end; i++) {
+            chunk_counts[shard_of(keys[i], shard_bits_)]++;
+        }
+    });
+
+    // Offsets of each chunk in each shard, in a shard-major layout so that
+    // the positions of a shard are contiguous and in increasing order
+    std::vector<size_t> offsets(num_chunks * num_shards);
+    std::vector<size_t> shard_offsets(num_shards + 1, 0);
+    size_t offset = 0;
+    for (size_t shard = 0; shard < num_shards; shard++) {
+        shard_offsets[shard] = offset;
+        for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+            offsets[chunk * num_shards + shard] = offset;
+            offset += counts[chunk * num_shards + shard];
+        }
+    }
+    shard_offsets[num_shards] = offset;
+
+    // Partition the key positions by shard
+    std::vector<size_t> positions(size);
+    parallel_for(num_chunks, [&](size_t chunk) {
+        size_t* chunk_offsets = &offsets[chunk * num_shards];
+        size_t end = std::min(size, (chunk + 1) * chunk_size);
+        for (size_t i = chunk * chunk_size; i < end; i++) {
+            positions[chunk_offsets[shard_of(keys[i], shard_bits_)]++] = i;
+        }
+    });
+
+    // Build the shards
+    std::vector<uint8_t> shard_unique(num_shards, 1);
+    parallel_for(num_shards, [&](size_t shard) {
+        auto hash = shards_[shard];
+        for (size_t j = shard_offsets[shard]; j < shard_offsets[shard + 1];
+             j++) {
+            if (!insert_key(hash, keys[positions[j]], positions[j])) {
+                shard_unique[shard] = 0;
+                return;
+            }
+        }
+    });
+
+    return std::all_of(shard_unique.begin(), shard_unique.end(), [](auto u) {
+        return u != 0;
+    });
+}
+
+template <typename T>
+void IntIndexer::lookup(const T* keys, int64_t* results, size_t size) {
+    static_assert(std::is_integral_v<T>, "IntIndexer keys must be integers");
+    if (size == 0) {
+        return;
+    }
+    if (layout_ == Layout::string) {
+        throw std::runtime_error(
+            "Integer keys cannot be looked up in string keys.");
+    }
+    if (layout_ == Layout::hash && shards_.empty()) {
+        std::fill(results, results + size, -1);
+        return;
+    }
+    for_each_chunk(size, [this, keys, results](size_t start, size_t end) {
+        lookup_range(keys, results, start, end);
+    });
+}
+
+template <typename O>
+void IntIndexer::lookup(
+    const char* data, const O* offsets, int64_t* results, size_t size) {
     if (size == 0) {
         return;
     }
+    if (map_size_ == 0) {
+        std::fill(results, results + size, -1);
+        return;
+    }
+    if (layout_ != Layout::string) {
+        throw std::runtime_error(
+            "String keys cannot be looked up in integer keys.");
+    }
+    for_each_chunk(
+        size, [this, data, offsets, results](size_t start, size_t end) {
+            for (size_t i = start; i < end; i++) {
+                auto it = string_index_.find(std::string_view(
+                    data + offsets[i], offsets[i + 1] - offsets[i]));
+                // According to pandas behavior
+                results[i] = it == string_index_.end() ? -1 : it->second;
+            }
+        });
+}
+
+void IntIndexer::lookup(
+    const std::vector<std::string>& keys, std::vector<int64_t>& results) {
+    check_results_size(keys.size(), results.size());
+    std::vector<uint64_t> offsets(keys.size() + 1, 0);
+    for (size_t i = 0; i < keys.size(); i++) {
+        offsets[i + 1] = offsets[i] + keys[i].size();
+    }
+    std::string data;
+    data.reserve(offsets.back());
+    for (const auto& key : keys) {
+        data += key;
+    }
+    lookup(data.data(), offsets.data(), results.data(), keys.size());
+}
+
+void IntIndexer::for_each_chunk(
+    size_t size, const std::function<void(size_t, size_t)>& fn) {
     // Single thread checks
     if (context_ == nullptr || context_->thread_pool() == nullptr ||
         context_->thread_pool()->concurrency_level() == 1) {
-        for (size_t i = 0; i < size; i++) {
-            auto k = kh_get(m64, hash_, keys[i]);
-            if (k == kh_end(hash_)) {
-                // According to pandas behavior
-                results[i] = -1;
-            } else {
-                results[i] = kh_val(hash_, k);
-            }
-        }
+        fn(0, size);
         return;
     }
     LOG_DEBUG(fmt::format(
@@ -117,16 +343,8 @@ void IntIndexer::lookup(const int64_t* keys, int64_t* results, size_t size) {
         LOG_DEBUG(fmt::format(
             "Creating tileDB task for the range from {} to {} ", start, end));
         tiledbsoma::ThreadPool::Task task = context_->thread_pool()->execute(
-            [this, start, end, &results, &keys]() {
-                for (size_t i = start; i < end; i++) {
-                    auto k = kh_get(m64, hash_, keys[i]);
-                    if (k == kh_end(hash_)) {
-                        // According to pandas behavior
-                        results[i] = -1;
-                    } else {
-                        results[i] = kh_val(hash_, k);
-                    }
-                }
+            [start, end, &fn]() {
+                fn(start, end);
                 return tiledbsoma::Status::Ok();
             });
         assert(task.valid());
@@ -139,10 +357,135 @@ void IntIndexer::lookup(const int64_t* keys, int64_t* results, size_t size) {
     context_->thread_pool()->wait_all(tasks);
 }
 
-IntIndexer::~IntIndexer() {
-    if (map_size_ > 0) {
-        kh_destroy(m64, this->hash_);
+template <typename T>
+bool IntIndexer::map_sorted(const T* keys, size_t size) {
+    for (size_t i = 1; i < size; i++) {
+        if (keys[i] <= keys[i - 1]) {
+            return false;
+        }
+    }
+
+    // Span of the keys minus one, which does not overflow
+    uint64_t last_offset = static_cast<uint64_t>(keys[size - 1]) -
+                           static_cast<uint64_t>(keys[0]);
+    base_ = keys[0];
+    if (last_offset == size - 1) {
+        layout_ = Layout::range;
+        return true;
+    }
+    if (last_offset / MAX_BITMAP_SPAN_PER_KEY >= size) {
+        return false;
+    }
+
+    bitmap_.assign(last_offset / 64 + 1, 0);
+    for (size_t i = 0; i < size; i++) {
+        uint64_t offset = static_cast<uint64_t>(keys[i]) -
+                          static_cast<uint64_t>(base_);
+        bitmap_[offset / 64] |= uint64_t(1) << (offset % 64);
+    }
+    bitmap_rank_.resize(bitmap_.size());
+    uint64_t rank = 0;
+    for (size_t w = 0; w < bitmap_.size(); w++) {
+        bitmap_rank_[w] = rank;
+        rank += std::bitset<64>(bitmap_[w]).count();
+    }
+    layout_ = Layout::bitmap;
+    return true;
+}
+
+template <typename T>
+void IntIndexer::lookup_range(
+    const T* keys, int64_t* results, size_t start, size_t end) const {
+    // Keys below base_ wrap around to large offsets and are not found
+    switch (layout_) {
+        case Layout::range: {
+            uint64_t num_keys = map_size_;
+            for (size_t i = start; i < end; i++) {
+                uint64_t offset = static_cast<uint64_t>(keys[i]) -
+                                  static_cast<uint64_t>(base_);
+                results[i] = offset < num_keys ? static_cast<int64_t>(offset) :
+                                                 -1;
+            }
+            break;
+        }
+        case Layout::bitmap: {
+            uint64_t span = bitmap_.size() * 64;
+            for (size_t i = start; i < end; i++) {
+                uint64_t offset = static_cast<uint64_t>(keys[i]) -
+                                  static_cast<uint64_t>(base_);
+                if (offset >= span) {
+                    results[i] = -1;
+                    continue;
+                }
+                uint64_t word = bitmap_[offset / 64];
+                uint64_t bit = uint64_t(1) << (offset % 64);
+                if (word & bit) {
+                    results[i] = bitmap_rank_[offset / 64] +
+                                 std::bitset<64>(word & (bit - 1)).count();
+                } else {
+                    results[i] = -1;
+                }
+            }
+            break;
+        }
+        case Layout::hash: {
+            for (size_t i = start; i < end; i++) {
+                auto hash = shards_[shard_of(keys[i], shard_bits_)];
+                auto k = kh_get(m64, hash, keys[i]);
+                if (k == kh_end(hash)) {
+                    // According to pandas behavior
+                    results[i] = -1;
+                } else {
+                    results[i] = kh_val(hash, k);
+                }
+            }
+            break;
+        }
+        case Layout::string:
+            // Rejected by lookup
+            break;
     }
 }
 
+void IntIndexer::clear() {
+    for (auto shard : shards_) {
+        kh_destroy(m64, shard);
+    }
+    shards_.clear();
+    shard_bits_ = 0;
+    layout_ = Layout::hash;
+    bitmap_.clear();
+    bitmap_rank_.clear();
+    string_index_.clear();
+    string_arena_.clear();
+}
+
+IntIndexer::~IntIndexer() {
+    clear();
+}
+
+template void IntIndexer::map_locations(const int8_t*, size_t);
+template void IntIndexer::map_locations(const uint8_t*, size_t);
+template void IntIndexer::map_locations(const int16_t*, size_t);
+template void IntIndexer::map_locations(const uint16_t*, size_t);
+template void IntIndexer::map_locations(const int32_t*, size_t);
+template void IntIndexer::map_locations(const uint32_t*, size_t);
+template void IntIndexer::map_locations(const int64_t*, size_t);
+template void IntIndexer::map_locations(const uint64_t*, size_t);
+template void IntIndexer::map_locations(const char*, const uint32_t*, size_t);
+template void IntIndexer::map_locations(const char*, const uint64_t*, size_t);
+
+template void IntIndexer::lookup(const int8_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const uint8_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const int16_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const uint16_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const int32_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const uint32_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const int64_t*, int64_t*, size_t);
+template void IntIndexer::lookup(const uint64_t*, int64_t*, size_t);
+template void IntIndexer::lookup(
+    const char*, const uint32_t*, int64_t*, size_t);
+template void IntIndexer::lookup(
+    const char*, const uint64_t*, int64_t*, size_t);
+
 }  // namespace tiledbsoma
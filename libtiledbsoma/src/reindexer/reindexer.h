@@ -34,8 +34,13 @@
 #define TILEDBSOMA_REINDEXER_H
 
 #include <assert.h>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 struct kh_m64_s;
@@ -47,31 +52,65 @@ class SOMAContext;
 class IntIndexer {
    public:
     /**
-     * Perform intitalization of hash and threadpool
-     * @param keys pointer to key array of 64bit integers
+     * Perform intitalization of hash and threadpool. Sorted keys that form
+     * a contiguous range, or a dense enough set, are mapped arithmetically or
+     * with a bitmap instead of a hash table. With a context, large key sets
+     * hashed are split into one shard per thread, and the shards are built in
+     * parallel.
+     * @tparam T key type: int32_t, uint32_t, int64_t or uint64_t
+     * @param keys pointer to key array of integers
      * @param size yhr number of keys in the put
-     * @param threads number of threads in the thread pool
      */
-    void map_locations(const int64_t* keys, size_t size);
-    void map_locations(const std::vector<int64_t>& keys) {
+    template <typename T>
+    void map_locations(const T* keys, size_t size);
+    template <typename T>
+    void map_locations(const std::vector<T>& keys) {
         map_locations(keys.data(), keys.size());
     }
+
+    /**
+     * Map string keys, given as the data and offsets buffers of an Arrow
+     * string array. The strings are copied to an arena owned by the indexer
+     * and hashed from there.
+     * @tparam O offset type: uint32_t (string) or uint64_t (large string)
+     * @param data string data
+     * @param offsets size + 1 offsets into data
+     * @param size the number of keys
+     */
+    template <typename O>
+    void map_locations(const char* data, const O* offsets, size_t size);
+    void map_locations(const std::vector<std::string>& keys);
+
     /**
-     * Used for parallel lookup using khash
+     * Used for parallel lookup using khash. The keys may have a different
+     * integer type than the keys mapped; they are compared as int64_t.
      * @param keys array of keys to lookup
      * @param result array for lookup results
      * @param size // Number of key array
      * @return and array of looked up value (same size as keys)
      */
-    void lookup(const int64_t* keys, int64_t* results, size_t size);
-    void lookup(
-        const std::vector<int64_t>& keys, std::vector<int64_t>& results) {
-        if (keys.size() != results.size())
-            throw std::runtime_error(
-                "The size of input and results arrays must be the same.");
-
+    template <typename T>
+    void lookup(const T* keys, int64_t* results, size_t size);
+    template <typename T>
+    void lookup(const std::vector<T>& keys, std::vector<int64_t>& results) {
+        check_results_size(keys.size(), results.size());
         lookup(keys.data(), results.data(), keys.size());
     }
+
+    /**
+     * Look up string keys, given as the data and offsets buffers of an Arrow
+     * string array, among the string keys mapped.
+     * @param data string data
+     * @param offsets size + 1 offsets into data
+     * @param results array for lookup results
+     * @param size the number of keys
+     */
+    template <typename O>
+    void lookup(
+        const char* data, const O* offsets, int64_t* results, size_t size);
+    void lookup(
+        const std::vector<std::string>& keys, std::vector<int64_t>& results);
+
     IntIndexer(){};
     IntIndexer(std::shared_ptr<tiledbsoma::SOMAContext> context)
         : context_(context) {
@@ -80,9 +119,102 @@ class IntIndexer {
 
    private:
     /*
-     * The created 64bit hash table
+     * How keys are mapped to their position
+     */
+    enum class Layout {
+        // The keys are in the hash tables
+        hash,
+        // The keys are the contiguous range [base_, base_ + map_size_)
+        range,
+        // The keys are sorted, and are the set bits of bitmap_ from base_
+        bitmap,
+        // The keys are strings in string_index_
+        string
+    };
+
+    /*
+     * Minimum number of keys for building the hash table in parallel
+     */
+    static constexpr size_t MIN_PARALLEL_MAP_SIZE = 1 << 16;
+
+    /*
+     * Maximum ratio of the key span to the number of keys for the bitmap
+     * layout. At 2 bits of bitmap and rank per value of the span, the
+     * bitmap is then still smaller than the hash table.
+     */
+    static constexpr uint64_t MAX_BITMAP_SPAN_PER_KEY = 64;
+
+    Layout layout_ = Layout::hash;
+
+    /*
+     * Smallest key of the range and bitmap layouts
+     */
+    int64_t base_ = 0;
+
+    /*
+     * Bitmap of the keys from base_, and number of keys before each word of
+     * the bitmap
+     */
+    std::vector<uint64_t> bitmap_;
+    std::vector<uint64_t> bitmap_rank_;
+
+    /*
+     * The created 64bit hash tables, one per shard. A key is stored in the
+     * shard selected by the top shard_bits_ bits of its hash.
+     */
+    std::vector<kh_m64_s*> shards_;
+    unsigned shard_bits_ = 0;
+
+    /*
+     * Partition the keys by shard and build the shards on the thread pool
+     * @return false if a key is duplicated
+     */
+    template <typename T>
+    bool map_shards(const T* keys, size_t size);
+
+    /*
+     * Copy of the string keys, and index of the strings in the arena
+     */
+    std::vector<char> string_arena_;
+    std::unordered_map<std::string_view, int64_t> string_index_;
+
+    /*
+     * Build the hash tables of integer keys
+     */
+    template <typename T>
+    void map_integers(const T* keys, size_t size);
+
+    /*
+     * Use the range or bitmap layout if the keys are sorted and dense enough
+     * @return false if the keys need the hash tables
+     */
+    template <typename T>
+    bool map_sorted(const T* keys, size_t size);
+
+    /*
+     * Look up keys[start, end) into results[start, end)
+     */
+    template <typename T>
+    void lookup_range(
+        const T* keys, int64_t* results, size_t start, size_t end) const;
+
+    /*
+     * Run fn(start, end) on chunks of [0, size), in parallel if the context
+     * has a thread pool
+     */
+    void for_each_chunk(
+        size_t size, const std::function<void(size_t, size_t)>& fn);
+
+    void check_results_size(size_t keys_size, size_t results_size) {
+        if (keys_size != results_size)
+            throw std::runtime_error(
+                "The size of input and results arrays must be the same.");
+    }
+
+    /*
+     * Release the hash tables, bitmap and strings
      */
-    kh_m64_s* hash_;
+    void clear();
 
     std::shared_ptr<SOMAContext> context_ = nullptr;
     /*
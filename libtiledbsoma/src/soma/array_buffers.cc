@@ -55,4 +55,13 @@ void ArrayBuffers::emplace(
     buffers_.emplace(name, buffer);
 }
 
+bool ArrayBuffers::in_use() const {
+    for (const auto& [name, buffer] : buffers_) {
+        if (buffer.use_count() > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace tiledbsoma
\ No newline at end of file
@@ -96,6 +96,15 @@ class ArrayBuffers {
         return buffers_.at(names_.front())->size();
     }
 
+    /**
+     * @brief Return true if any column buffer is referenced outside of this
+     * ArrayBuffers, for example by an exported Arrow array that has not been
+     * released yet.
+     *
+     * @return True if a column buffer is in use
+     */
+    bool in_use() const;
+
    private:
     // A vector of column names that maintains the order the columns were added
     std::vector<std::string> names_;
@@ -31,6 +31,7 @@
  */
 
 #include "column_buffer.h"
+#include <cstring>
 #include "../utils/logger.h"
 
 namespace tiledbsoma {
@@ -42,7 +43,10 @@ using namespace tiledb;
 //===================================================================
 
 std::shared_ptr<ColumnBuffer> ColumnBuffer::create(
-    std::shared_ptr<Array> array, std::string_view name) {
+    std::shared_ptr<Array> array,
+    std::string_view name,
+    std::optional<size_t> num_cells,
+    std::optional<size_t> num_bytes) {
     auto schema = array->schema();
     auto name_str = std::string(name);  // string for TileDB API
 
@@ -75,7 +79,9 @@ std::shared_ptr<ColumnBuffer> ColumnBuffer::create(
             is_var,
             is_nullable,
             enumeration,
-            is_ordered);
+            is_ordered,
+            num_cells,
+            num_bytes);
 
     } else if (schema.domain().has_dimension(name_str)) {
         auto dim = schema.domain().dimension(name_str);
@@ -97,12 +103,27 @@ std::shared_ptr<ColumnBuffer> ColumnBuffer::create(
             is_var,
             false,
             std::nullopt,
-            false);
+            false,
+            num_cells,
+            num_bytes);
     }
 
     throw TileDBSOMAError("[ColumnBuffer] Column name not found: " + name_str);
 }
 
+size_t ColumnBuffer::max_alloc_bytes(Config config) {
+    return config_bytes(config, CONFIG_KEY_MAX_BYTES, DEFAULT_MAX_ALLOC_BYTES);
+}
+
+std::optional<size_t> ColumnBuffer::read_budget_bytes(Config config) {
+    if (!config.contains(CONFIG_KEY_READ_BUDGET) &&
+        config.contains(CONFIG_KEY_INIT_BYTES)) {
+        return std::nullopt;
+    }
+    return config_bytes(
+        config, CONFIG_KEY_READ_BUDGET, DEFAULT_READ_BUDGET_BYTES);
+}
+
 void ColumnBuffer::to_bitmap(tcb::span<uint8_t> bytemap) {
     int i_dst = 0;
     for (unsigned int i_src = 0; i_src < bytemap.size(); i_src++) {
@@ -120,6 +141,17 @@ void ColumnBuffer::to_bitmap(tcb::span<uint8_t> bytemap) {
     }
 }
 
+void ColumnBuffer::from_bitmap(
+    const uint8_t* bitmap,
+    uint64_t bit_offset,
+    uint64_t num_elems,
+    uint8_t* bytemap) {
+    for (uint64_t i = 0; i < num_elems; i++) {
+        uint64_t bit = bit_offset + i;
+        bytemap[i] = (bitmap[bit / 8] >> (bit % 8)) & 0x01;
+    }
+}
+
 //===================================================================
 //= public non-static
 //===================================================================
@@ -147,16 +179,7 @@ ColumnBuffer::ColumnBuffer(
         num_bytes,
         is_var_,
         is_nullable_));
-    // Call reserve() to allocate memory without initializing the contents.
-    // This reduce the time to allocate the buffer and reduces the
-    // resident memory footprint of the buffer.
-    data_.reserve(num_bytes);
-    if (is_var_) {
-        offsets_.reserve(num_cells + 1);  // extra offset for arrow
-    }
-    if (is_nullable_) {
-        validity_.reserve(num_cells);
-    }
+    reserve(num_cells, num_bytes);
 }
 
 ColumnBuffer::~ColumnBuffer() {
@@ -182,6 +205,72 @@ void ColumnBuffer::attach(Query& query) {
     }
 }
 
+bool ColumnBuffer::expand(size_t max_bytes) {
+    size_t num_bytes = data_.capacity();
+    if (num_bytes >= max_bytes) {
+        return false;
+    }
+    num_bytes = std::min(std::max(2 * num_bytes, sizeof(uint64_t)), max_bytes);
+    size_t num_cells = is_var_ ? std::max<size_t>(2 * cell_capacity(), 1) :
+                                 num_bytes / type_size_;
+
+    LOG_DEBUG(fmt::format(
+        "[ColumnBuffer] '{}' expanding to {} cells, {} bytes",
+        name_,
+        num_cells,
+        num_bytes));
+
+    // The buffer holds no results when it is expanded, so release the old
+    // allocation before reserving the new one instead of copying it over.
+    data_ = std::vector<std::byte>();
+    offsets_ = std::vector<uint64_t>();
+    validity_ = std::vector<uint8_t>();
+    reserve(num_cells, num_bytes);
+    num_cells_ = 0;
+    return true;
+}
+
+void ColumnBuffer::attach_remaining(Query& query) {
+    append_bytes_ = is_var_ ? offsets_[num_cells_] : num_cells_ * type_size_;
+    query.set_data_buffer(
+        name_,
+        (void*)(data_.data() + append_bytes_),
+        (data_.capacity() - append_bytes_) / type_size_);
+    if (is_var_) {
+        query.set_offsets_buffer(
+            name_,
+            offsets_.data() + num_cells_,
+            offsets_.capacity() - 1 - num_cells_);
+    }
+    if (is_nullable_) {
+        query.set_validity_buffer(
+            name_,
+            validity_.data() + num_cells_,
+            validity_.capacity() - num_cells_);
+    }
+}
+
+size_t ColumnBuffer::update_size_appended(const Query& query) {
+    auto [num_offsets, num_elements] = query.result_buffer_elements()[name_];
+
+    size_t num_appended;
+    if (is_var()) {
+        num_appended = num_offsets;
+        // TileDB wrote offsets relative to the start of the appended data
+        for (size_t i = num_cells_; i < num_cells_ + num_appended; i++) {
+            offsets_[i] += append_bytes_;
+        }
+        // Set the extra offset value for arrow.
+        offsets_[num_cells_ + num_appended] = append_bytes_ +
+                                              num_elements * type_size_;
+    } else {
+        num_appended = num_elements;
+    }
+    num_cells_ += num_appended;
+
+    return num_appended;
+}
+
 size_t ColumnBuffer::update_size(const Query& query) {
     auto [num_offsets, num_elements] = query.result_buffer_elements()[name_];
 
@@ -206,12 +295,143 @@ std::vector<std::string> ColumnBuffer::strings() {
     return result;
 }
 
+void ColumnBuffer::set_data_view(
+    uint64_t num_elems,
+    const void* data,
+    const uint64_t* offsets,
+    const uint8_t* validity,
+    uint64_t validity_offset) {
+    num_cells_ = num_elems;
+    data_view_ = static_cast<const std::byte*>(data);
+    offsets_view_ = nullptr;
+
+    if (offsets != nullptr) {
+        // TileDB offsets are relative to the start of the data buffer, so
+        // offsets of a sliced Arrow array are rebased to their first value
+        auto first = offsets[0];
+        if (first == 0) {
+            offsets_view_ = offsets;
+        } else {
+            offsets_.resize(num_elems + 1);
+            for (uint64_t i = 0; i <= num_elems; i++) {
+                offsets_[i] = offsets[i] - first;
+            }
+            data_view_ += first;
+        }
+        data_size_ = offsets[num_elems] - first;
+    } else {
+        data_size_ = num_elems;
+    }
+
+    set_validity(num_elems, validity, validity_offset);
+}
+
+void ColumnBuffer::set_data_view(
+    uint64_t num_elems,
+    const void* data,
+    const uint32_t* offsets,
+    const uint8_t* validity,
+    uint64_t validity_offset) {
+    num_cells_ = num_elems;
+    offsets_view_ = nullptr;
+
+    auto first = offsets[0];
+    offsets_.resize(num_elems + 1);
+    for (uint64_t i = 0; i <= num_elems; i++) {
+        offsets_[i] = offsets[i] - first;
+    }
+    data_view_ = static_cast<const std::byte*>(data) + first;
+    data_size_ = offsets_[num_elems];
+
+    set_validity(num_elems, validity, validity_offset);
+}
+
+void ColumnBuffer::append(ColumnBuffer& other) {
+    auto num_other = other.size();
+    auto current_bytes = data_bytes();
+    auto other_bytes = other.data_bytes();
+
+    data_.resize(current_bytes + other_bytes);
+    std::memcpy(
+        data_.data() + current_bytes,
+        other.data<std::byte>().data(),
+        other_bytes);
+
+    if (is_var_) {
+        // Shift the offsets of the other buffer past the current data
+        auto other_offsets = other.offsets();
+        offsets_.resize(num_cells_ + num_other + 1);
+        for (uint64_t i = 0; i < num_other; i++) {
+            offsets_[num_cells_ + i] = current_bytes + other_offsets[i];
+        }
+        offsets_[num_cells_ + num_other] = current_bytes + other_bytes;
+    }
+
+    if (is_nullable_) {
+        auto other_validity = other.validity();
+        validity_.resize(num_cells_);
+        validity_.insert(
+            validity_.end(), other_validity.begin(), other_validity.end());
+    }
+
+    num_cells_ += num_other;
+    data_size_ = is_var_ ? current_bytes + other_bytes : num_cells_;
+}
+
+void ColumnBuffer::set_bitmap_data(
+    uint64_t num_elems,
+    const uint8_t* data,
+    uint64_t bit_offset,
+    const uint8_t* validity) {
+    num_cells_ = num_elems;
+    data_view_ = nullptr;
+    offsets_view_ = nullptr;
+
+    data_.resize(num_elems);
+    ColumnBuffer::from_bitmap(
+        data, bit_offset, num_elems, reinterpret_cast<uint8_t*>(data_.data()));
+    data_size_ = num_elems;
+
+    set_validity(num_elems, validity, bit_offset);
+}
+
 std::string_view ColumnBuffer::string_view(uint64_t index) {
     auto start = offsets_[index];
     auto len = offsets_[index + 1] - start;
     return std::string_view((char*)(data_.data() + start), len);
 }
 
+//===================================================================
+//= private non-static
+//===================================================================
+
+void ColumnBuffer::reserve(size_t num_cells, size_t num_bytes) {
+    // Call reserve() to allocate memory without initializing the contents.
+    // This reduce the time to allocate the buffer and reduces the
+    // resident memory footprint of the buffer.
+    data_.reserve(num_bytes);
+    if (is_var_) {
+        offsets_.reserve(num_cells + 1);  // extra offset for arrow
+    }
+    if (is_nullable_) {
+        validity_.reserve(num_cells);
+    }
+}
+
+void ColumnBuffer::set_validity(
+    uint64_t num_elems, const uint8_t* validity, uint64_t validity_offset) {
+    if (!is_nullable_) {
+        return;
+    }
+    validity_.resize(num_elems);
+    if (validity != nullptr) {
+        ColumnBuffer::from_bitmap(
+            validity, validity_offset, num_elems, validity_.data());
+    } else {
+        std::fill(validity_.begin(), validity_.end(), 1);
+    }
+}
+
 //===================================================================
 //= private static
 //===================================================================
@@ -223,22 +443,13 @@ std::shared_ptr<ColumnBuffer> ColumnBuffer::alloc(
     bool is_var,
     bool is_nullable,
     std::optional<Enumeration> enumeration,
-    bool is_ordered) {
+    bool is_ordered,
+    std::optional<size_t> requested_cells,
+    std::optional<size_t> requested_bytes) {
     // Set number of bytes for the data buffer. Override with a value from
-    // the config if present.
-    auto num_bytes = DEFAULT_ALLOC_BYTES;
-    if (config.contains(CONFIG_KEY_INIT_BYTES)) {
-        auto value_str = config.get(CONFIG_KEY_INIT_BYTES);
-        try {
-            num_bytes = std::stoull(value_str);
-        } catch (const std::exception& e) {
-            throw TileDBSOMAError(fmt::format(
-                "[ColumnBuffer] Error parsing {}: '{}' ({})",
-                CONFIG_KEY_INIT_BYTES,
-                value_str,
-                e.what()));
-        }
-    }
+    // the config if present, or with the caller's request.
+    auto num_bytes = requested_bytes.value_or(
+        config_bytes(config, CONFIG_KEY_INIT_BYTES, DEFAULT_ALLOC_BYTES));
 
     // bool is_dense = schema.array_type() == TILEDB_DENSE;
     // if (is_dense) {
@@ -250,8 +461,9 @@ std::shared_ptr<ColumnBuffer> ColumnBuffer::alloc(
     //   offset type.
     // For non-variable length column types, the number of cells is computed
     //   from the type size.
-    size_t num_cells = is_var ? num_bytes / sizeof(uint64_t) :
-                                num_bytes / tiledb::impl::type_size(type);
+    size_t num_cells = requested_cells.value_or(
+        is_var ? num_bytes / sizeof(uint64_t) :
+                 num_bytes / tiledb::impl::type_size(type));
 
     return std::make_shared<ColumnBuffer>(
         name,
@@ -264,4 +476,21 @@ std::shared_ptr<ColumnBuffer> ColumnBuffer::alloc(
         is_ordered);
 }
 
+size_t ColumnBuffer::config_bytes(
+    Config config, const std::string& key, size_t default_bytes) {
+    if (!config.contains(key)) {
+        return default_bytes;
+    }
+    auto value_str = config.get(key);
+    try {
+        return std::stoull(value_str);
+    } catch (const std::exception& e) {
+        throw TileDBSOMAError(fmt::format(
+            "[ColumnBuffer] Error parsing {}: '{}' ({})",
+            key,
+            value_str,
+            e.what()));
+    }
+}
+
 }  // namespace tiledbsoma
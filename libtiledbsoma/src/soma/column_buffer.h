@@ -47,6 +47,37 @@ namespace tiledbsoma {
 
 using namespace tiledb;
 
+/**
+ * @brief Values of an enumeration and the Arrow dictionary buffers (data and
+ * 32-bit offsets) built from them. Built once per open array and shared by
+ * the ColumnBuffers of every batch, so that the dictionary is not fetched and
+ * converted again for each batch.
+ */
+struct EnumerationBuffers {
+    EnumerationBuffers(std::vector<std::string> vec)
+        : values(std::move(vec)) {
+        offsets.reserve(values.size() + 1);
+        uint32_t cumlen = 0;
+        for (auto& value : values) {
+            offsets.push_back(cumlen);
+            cumlen += static_cast<uint32_t>(value.length());
+        }
+        offsets.push_back(cumlen);
+
+        data.reserve(cumlen);
+        for (auto& value : values) {
+            data += value;
+        }
+    }
+
+    // Enumeration values
+    std::vector<std::string> values;
+
+    // Enumeration values as concatenated string data and offsets
+    std::string data;
+    std::vector<uint32_t> offsets;
+};
+
 /**
  * @brief Class to store data for a TileDB dimension or attribute.
  *
@@ -61,6 +92,21 @@ class ColumnBuffer {
     inline static const std::string
         CONFIG_KEY_INIT_BYTES = "soma.init_buffer_bytes";
 
+    // Upper bound for growing a buffer when a single cell does not fit in the
+    // initial allocation (e.g. a very large string or blob). Growth is
+    // geometric, so this is reached after a handful of retries.
+    inline static const size_t DEFAULT_MAX_ALLOC_BYTES = size_t(1) << 34;
+    inline static const std::string
+        CONFIG_KEY_MAX_BYTES = "soma.max_buffer_bytes";
+
+    // Total number of bytes for all read buffers of a query, split across the
+    // selected columns by their estimated bytes per cell so that every column
+    // holds the same number of cells. Setting `soma.init_buffer_bytes`
+    // without this key selects the previous fixed size per column instead.
+    inline static const size_t DEFAULT_READ_BUDGET_BYTES = size_t(1) << 31;
+    inline static const std::string
+        CONFIG_KEY_READ_BUDGET = "soma.read_budget_bytes";
+
    public:
     //===================================================================
     //= public static
@@ -71,10 +117,36 @@ class ColumnBuffer {
      *
      * @param array TileDB array
      * @param name TileDB dimension or attribute name
+     * @param num_cells Optional number of cells to allocate for offsets and
+     * validity. If not set, it is derived from `num_bytes`.
+     * @param num_bytes Optional number of bytes to allocate for data,
+     * overriding `soma.init_buffer_bytes`
      * @return ColumnBuffer
      */
     static std::shared_ptr<ColumnBuffer> create(
-        std::shared_ptr<Array> array, std::string_view name);
+        std::shared_ptr<Array> array,
+        std::string_view name,
+        std::optional<size_t> num_cells = std::nullopt,
+        std::optional<size_t> num_bytes = std::nullopt);
+
+    /**
+     * @brief Return the maximum number of bytes a data buffer may grow to,
+     * as set by `soma.max_buffer_bytes`.
+     *
+     * @param config TileDB Config
+     * @return size_t
+     */
+    static size_t max_alloc_bytes(Config config);
+
+    /**
+     * @brief Return the total number of bytes to split across the read
+     * buffers of a query, as set by `soma.read_budget_bytes`, or std::nullopt
+     * if each buffer should be allocated `soma.init_buffer_bytes` instead.
+     *
+     * @param config TileDB Config
+     * @return std::optional<size_t>
+     */
+    static std::optional<size_t> read_budget_bytes(Config config);
 
     /**
      * @brief Convert a bytemap to a bitmap in place.
@@ -82,6 +154,17 @@ class ColumnBuffer {
      */
     static void to_bitmap(tcb::span<uint8_t> bytemap);
 
+    /**
+     * @brief Expand `num_elems` bits of a bitmap, starting at bit
+     * `bit_offset`, to a bytemap.
+     *
+     */
+    static void from_bitmap(
+        const uint8_t* bitmap,
+        uint64_t bit_offset,
+        uint64_t num_elems,
+        uint8_t* bytemap);
+
     //===================================================================
     //= public non-static
     //===================================================================
@@ -121,6 +204,26 @@ class ColumnBuffer {
      */
     void attach(Query& query);
 
+    /**
+     * @brief Attach the unused part of this ColumnBuffer to a TileDB query,
+     * so that the next submit of an incomplete read appends to the cells
+     * already in the buffer.
+     *
+     * @param query TileDB query
+     */
+    void attach_remaining(Query& query);
+
+    /**
+     * @brief Drop the cells in the buffer, keeping its allocation, so that
+     * the buffer can be attached to another submit.
+     */
+    void clear() {
+        num_cells_ = 0;
+        append_bytes_ = 0;
+        data_view_ = nullptr;
+        offsets_view_ = nullptr;
+    }
+
     /**
      * @brief Set the ColumnBuffer's data.
      *
@@ -133,6 +236,8 @@ class ColumnBuffer {
         uint64_t* offsets = nullptr,
         uint8_t* validity = nullptr) {
         num_cells_ = num_elems;
+        data_view_ = nullptr;
+        offsets_view_ = nullptr;
 
         if (offsets != nullptr) {
             auto num_offsets = num_elems + 1;
@@ -150,19 +255,7 @@ class ColumnBuffer {
                 (std::byte*)data, (std::byte*)data + num_elems * type_size_);
         }
 
-        if (is_nullable_) {
-            if (validity != nullptr) {
-                for (uint64_t i = 0; i * 8 < num_elems; ++i) {
-                    uint8_t byte = ((uint8_t*)validity)[i];
-                    for (int64_t j = 0; j < 8 && i * 8 + j < num_elems; ++j) {
-                        validity_.push_back((uint8_t)((byte >> j) & 0x01));
-                    }
-                }
-            } else {
-                validity_.resize(num_elems);
-                std::fill(validity_.begin(), validity_.end(), 1);
-            }
-        }
+        set_validity(num_elems, validity);
     }
 
     /**
@@ -178,6 +271,8 @@ class ColumnBuffer {
         uint32_t* offsets,
         uint8_t* validity = nullptr) {
         num_cells_ = num_elems;
+        data_view_ = nullptr;
+        offsets_view_ = nullptr;
 
         auto num_offsets = num_elems + 1;
         std::vector<uint32_t> offset_holder;
@@ -191,21 +286,83 @@ class ColumnBuffer {
         data_.resize(data_size_);
         data_.assign((std::byte*)data, (std::byte*)data + data_size_);
 
-        if (is_nullable_) {
-            validity_.resize(num_elems);
-            if (validity != nullptr) {
-                for (uint64_t i = 0; i * 8 < num_elems; ++i) {
-                    uint8_t byte = ((uint8_t*)validity)[i];
-                    for (int64_t j = 0; j < 8; ++j) {
-                        validity_.push_back((uint8_t)((byte >> j) & 0x01));
-                    }
-                }
-            } else {
-                std::fill(validity_.begin(), validity_.end(), 1);
-            }
-        }
+        set_validity(num_elems, validity);
+    }
+
+    /**
+     * @brief Point the ColumnBuffer at data owned by the caller instead of
+     * copying it. The buffers must stay valid until the write query using
+     * this ColumnBuffer has been submitted.
+     *
+     * Offsets not starting at 0 are rebased into the ColumnBuffer and the
+     * validity bitmap is expanded to the bytemap TileDB expects; nothing else
+     * is copied.
+     *
+     * @param num_elems the number of elements in the column
+     * @param data pointer to the first element, or to the start of the
+     * variable length data
+     * @param offsets optional num_elems + 1 offsets into the data
+     * @param validity optional validity bitmap
+     * @param validity_offset bit offset of the first element in the bitmap
+     */
+    void set_data_view(
+        uint64_t num_elems,
+        const void* data,
+        const uint64_t* offsets = nullptr,
+        const uint8_t* validity = nullptr,
+        uint64_t validity_offset = 0);
+
+    /**
+     * @brief Point the ColumnBuffer at string or binary data owned by the
+     * caller, with 32-bit offsets. The offsets are widened to 64 bits into
+     * the ColumnBuffer; the data is not copied.
+     *
+     * @param num_elems the number of elements in the column
+     * @param data pointer to the start of the variable length data
+     * @param offsets num_elems + 1 offsets into the data
+     * @param validity optional validity bitmap
+     * @param validity_offset bit offset of the first element in the bitmap
+     */
+    void set_data_view(
+        uint64_t num_elems,
+        const void* data,
+        const uint32_t* offsets,
+        const uint8_t* validity = nullptr,
+        uint64_t validity_offset = 0);
+
+    /**
+     * @brief Append a copy of the cells of another ColumnBuffer of the same
+     * column, used to accumulate the batches of a write.
+     *
+     * @param other ColumnBuffer to copy the cells from
+     */
+    void append(ColumnBuffer& other);
+
+    /**
+     * @brief Return the number of bytes of data held by the buffer.
+     *
+     * @return uint64_t
+     */
+    uint64_t data_bytes() const {
+        return is_var_ ? data_size_ : num_cells_ * type_size_;
     }
 
+    /**
+     * @brief Set the ColumnBuffer's data from a bitmap of booleans, expanded
+     * to one byte per element.
+     *
+     * @param num_elems the number of elements in the column
+     * @param data bitmap of the values
+     * @param bit_offset bit offset of the first element in the data and
+     * validity bitmaps
+     * @param validity optional validity bitmap
+     */
+    void set_bitmap_data(
+        uint64_t num_elems,
+        const uint8_t* data,
+        uint64_t bit_offset = 0,
+        const uint8_t* validity = nullptr);
+
     /**
      * @brief Size num_cells_ to match the read query results.
      *
@@ -213,6 +370,15 @@ class ColumnBuffer {
      */
     size_t update_size(const Query& query);
 
+    /**
+     * @brief Add the cells appended by the read query, after
+     * `attach_remaining`, to num_cells_.
+     *
+     * @param query TileDB query
+     * @return size_t Number of cells appended
+     */
+    size_t update_size_appended(const Query& query);
+
     /**
      * @brief Return the number of cells in the buffer.
      *
@@ -231,6 +397,35 @@ class ColumnBuffer {
         return data_size_;
     }
 
+    /**
+     * @brief Return the number of bytes allocated for the data buffer.
+     *
+     * @return size_t
+     */
+    size_t data_capacity() const {
+        return data_.capacity();
+    }
+
+    /**
+     * @brief Return the number of cells the buffer can hold.
+     *
+     * @return size_t
+     */
+    size_t cell_capacity() const {
+        return is_var_ ? offsets_.capacity() - 1 :
+                         data_.capacity() / type_size_;
+    }
+
+    /**
+     * @brief Discard the buffer contents and double its allocation, up to
+     * `max_bytes` of data. Used to retry a read when a single cell does not
+     * fit.
+     *
+     * @param max_bytes Maximum number of bytes for the data buffer
+     * @return true if the buffer was expanded, false if already at the limit
+     */
+    bool expand(size_t max_bytes);
+
     /**
      * @brief Return a view of the ColumnBuffer data.
      *
@@ -239,7 +434,8 @@ class ColumnBuffer {
      */
     template <typename T>
     tcb::span<T> data() {
-        return tcb::span<T>((T*)data_.data(), num_cells_);
+        auto data = data_view_ != nullptr ? data_view_ : data_.data();
+        return tcb::span<T>((T*)data, num_cells_);
     }
 
     /**
@@ -268,7 +464,9 @@ class ColumnBuffer {
                 "[ColumnBuffer] Offsets buffer not defined for " + name_);
         }
 
-        return tcb::span<uint64_t>(offsets_.data(), num_cells_);
+        auto offsets = offsets_view_ != nullptr ? offsets_view_ :
+                                                  offsets_.data();
+        return tcb::span<uint64_t>((uint64_t*)offsets, num_cells_);
     }
 
     /**
@@ -341,7 +539,15 @@ class ColumnBuffer {
      *
      */
     void add_enumeration(const std::vector<std::string>& vec) {
-        enums_ = vec;
+        add_enumeration(std::make_shared<EnumerationBuffers>(vec));
+    }
+
+    /**
+     * @brief Add an optional enumeration shared with other buffers.
+     *
+     */
+    void add_enumeration(std::shared_ptr<EnumerationBuffers> enums) {
+        enums_ = enums;
         has_enumeration_ = true;
     }
 
@@ -357,11 +563,23 @@ class ColumnBuffer {
      *
      */
     std::vector<std::string> get_enumeration() {
-        return enums_;
+        if (!has_enumeration_) {
+            return {};
+        }
+        return enums_->values;
+    }
+
+    /**
+     * @brief Return the number of enumeration values.
+     *
+     */
+    size_t enumeration_size() const {
+        return has_enumeration_ ? enums_->values.size() : 0;
     }
 
     /**
-     * @brief Convert enumeration (aka dictionary)
+     * @brief Convert enumeration (aka dictionary). The dictionary buffers are
+     * built when the enumeration is added, so this only checks that one was.
      *
      */
     void convert_enumeration() {
@@ -369,17 +587,6 @@ class ColumnBuffer {
             throw TileDBSOMAError(
                 "[ColumnBuffer] No enumeration defined for " + name_);
         }
-        const size_t n_vec = enums_.size();  // plus one for extra offset
-        enum_offsets_.resize(n_vec + 1);
-        enum_str_ = "";
-        uint32_t cumlen = 0;
-        for (size_t i = 0; i < n_vec; i++) {
-            std::string s(enums_[i]);
-            enum_str_ += s;
-            enum_offsets_[i] = cumlen;
-            cumlen += static_cast<uint32_t>(s.length());
-        }
-        enum_offsets_[n_vec] = cumlen;
     }
 
     /**
@@ -391,7 +598,8 @@ class ColumnBuffer {
             throw TileDBSOMAError(
                 "[ColumnBuffer] No enumeration defined for " + name_);
         }
-        return tcb::span<uint32_t>(enum_offsets_.data(), enum_offsets_.size());
+        return tcb::span<uint32_t>(
+            enums_->offsets.data(), enums_->offsets.size());
     }
 
     /**
@@ -403,7 +611,7 @@ class ColumnBuffer {
             throw TileDBSOMAError(
                 "[ColumnBuffer] No enumeration defined for " + name_);
         }
-        return tcb::span<char>(enum_str_.data(), enum_str_.length());
+        return tcb::span<char>(enums_->data.data(), enums_->data.length());
     }
 
     /**
@@ -428,6 +636,8 @@ class ColumnBuffer {
      * @param is_nullable True if nullable data
      * @param enumeration Optional Enumeration associated with column
      * @param is_ordered Optional Enumeration is ordered
+     * @param num_cells Optional number of cells for offsets and validity
+     * @param num_bytes Optional number of bytes for the data buffer
      * @return ColumnBuffer
      */
     static std::shared_ptr<ColumnBuffer> alloc(
@@ -437,12 +647,47 @@ class ColumnBuffer {
         bool is_var,
         bool is_nullable,
         std::optional<Enumeration> enumeration,
-        bool is_ordered);
+        bool is_ordered,
+        std::optional<size_t> num_cells,
+        std::optional<size_t> num_bytes);
+
+    /**
+     * @brief Return a byte count from the config, or the default if the key
+     * is not set.
+     *
+     * @param config TileDB Config
+     * @param key Config key
+     * @param default_bytes Value returned if the key is not set
+     * @return size_t
+     */
+    static size_t config_bytes(
+        Config config, const std::string& key, size_t default_bytes);
 
     //===================================================================
     //= private non-static
     //===================================================================
 
+    /**
+     * @brief Reserve memory for the data, offsets and validity buffers.
+     *
+     * @param num_cells Number of cells for offsets and validity
+     * @param num_bytes Number of bytes for data
+     */
+    void reserve(size_t num_cells, size_t num_bytes);
+
+    /**
+     * @brief Expand a validity bitmap into the validity buffer, or mark all
+     * elements valid if there is none.
+     *
+     * @param num_elems Number of elements
+     * @param validity Optional validity bitmap
+     * @param validity_offset Bit offset of the first element in the bitmap
+     */
+    void set_validity(
+        uint64_t num_elems,
+        const uint8_t* validity,
+        uint64_t validity_offset = 0);
+
     // Name of the column from the schema.
     std::string name_;
 
@@ -450,7 +695,7 @@ class ColumnBuffer {
     tiledb_datatype_t type_;
 
     // Data size which is calculated different for var vs non-var
-    uint64_t data_size_;
+    uint64_t data_size_ = 0;
 
     // Bytes per element.
     uint64_t type_size_;
@@ -458,6 +703,9 @@ class ColumnBuffer {
     // Number of cells.
     uint64_t num_cells_;
 
+    // Offset, in bytes, of the data appended after `attach_remaining`.
+    uint64_t append_bytes_ = 0;
+
     // If true, the data type is variable length
     bool is_var_;
 
@@ -476,15 +724,17 @@ class ColumnBuffer {
     // Validity buffer (optional).
     std::vector<uint8_t> validity_;
 
+    // Data and offsets borrowed from the caller by set_data_view, used
+    // instead of data_ and offsets_ when set.
+    const std::byte* data_view_ = nullptr;
+    const uint64_t* offsets_view_ = nullptr;
+
     // True if the array has at least one enumerations
     bool has_enumeration_ = false;
 
-    // Enumerations (optional)
-    std::vector<std::string> enums_;
+    // Enumerations (optional), with their Arrow dictionary buffers
+    std::shared_ptr<EnumerationBuffers> enums_;
 
-    // Enumerations (optional) as string and offsets
-    std::string enum_str_;
-    std::vector<uint32_t> enum_offsets_;
     bool is_ordered_ = false;
 };
 
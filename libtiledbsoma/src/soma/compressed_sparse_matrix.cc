@@ -0,0 +1,333 @@
+/**
+ * @file   compressed_sparse_matrix.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the CompressedSparseMatrix class.
+ */
+
+#include "compressed_sparse_matrix.h"
+#include <thread_pool/thread_pool.h>
+#include <algorithm>
+#include "../reindexer/reindexer.h"
+#include "../utils/logger.h"
+#include "soma_context.h"
+
+namespace tiledbsoma {
+
+using namespace tiledb;
+
+// Minimum number of cells processed by one task
+static const size_t MIN_CELLS_PER_TASK = 1 << 16;
+
+CompressedSparseMatrix::CompressedSparseMatrix(
+    std::shared_ptr<SOMAContext> ctx,
+    uint64_t num_rows,
+    uint64_t num_cols,
+    bool csr,
+    std::shared_ptr<IntIndexer> row_indexer,
+    std::shared_ptr<IntIndexer> col_indexer)
+    : ctx_(ctx)
+    , num_rows_(num_rows)
+    , num_cols_(num_cols)
+    , csr_(csr)
+    , row_indexer_(row_indexer)
+    , col_indexer_(col_indexer)
+    , indptr_((csr ? num_rows : num_cols) + 1, 0) {
+}
+
+void CompressedSparseMatrix::append(std::shared_ptr<ArrayBuffers> batch) {
+    if (compressed_) {
+        throw TileDBSOMAError(
+            "[CompressedSparseMatrix] Cannot append to a compressed matrix");
+    }
+    for (auto& name : {DIM_0, DIM_1, DATA}) {
+        if (!batch->contains(name)) {
+            throw TileDBSOMAError(fmt::format(
+                "[CompressedSparseMatrix] Batch has no '{}' column", name));
+        }
+    }
+
+    auto rows = batch->at(DIM_0);
+    auto cols = batch->at(DIM_1);
+    auto data = batch->at(DATA);
+    if (rows->type() != TILEDB_INT64 || cols->type() != TILEDB_INT64) {
+        throw TileDBSOMAError(
+            "[CompressedSparseMatrix] Coordinates must be int64");
+    }
+    if (data->is_var() || data->is_nullable()) {
+        throw TileDBSOMAError(fmt::format(
+            "[CompressedSparseMatrix] Unsupported '{}' column: values must be "
+            "fixed-size and not nullable",
+            DATA));
+    }
+    if (data_type_ == TILEDB_ANY) {
+        data_type_ = data->type();
+    } else if (data_type_ != data->type()) {
+        throw TileDBSOMAError(fmt::format(
+            "[CompressedSparseMatrix] '{}' type {} does not match {}",
+            DATA,
+            tiledb::impl::type_to_str(data->type()),
+            tiledb::impl::type_to_str(data_type_)));
+    }
+
+    // Copy only the cells read, not the whole buffers of the batch
+    auto size = data->size();
+    Batch coo{
+        to_matrix_coords(
+            rows->data<int64_t>().subspan(0, size), row_indexer_, num_rows_),
+        to_matrix_coords(
+            cols->data<int64_t>().subspan(0, size), col_indexer_, num_cols_),
+        {}};
+    auto values = reinterpret_cast<const std::byte*>(
+        data->data<uint8_t>().data());
+    coo.data.assign(
+        values, values + size * tiledb::impl::type_size(data_type_));
+
+    nnz_ += size;
+    batches_.push_back(std::move(coo));
+}
+
+std::vector<int64_t> CompressedSparseMatrix::to_matrix_coords(
+    tcb::span<int64_t> coords,
+    const std::shared_ptr<IntIndexer>& indexer,
+    uint64_t size) {
+    std::vector<int64_t> result(coords.size());
+    if (indexer) {
+        indexer->lookup(coords.data(), result.data(), coords.size());
+    } else {
+        std::copy(coords.begin(), coords.end(), result.begin());
+    }
+    for (auto coord : result) {
+        if (coord < 0 || static_cast<uint64_t>(coord) >= size) {
+            throw TileDBSOMAError(
+                "[CompressedSparseMatrix] Coordinate outside of the matrix "
+                "shape or missing from the indexer");
+        }
+    }
+    return result;
+}
+
+void CompressedSparseMatrix::compress() {
+    if (compressed_) {
+        return;
+    }
+    if (data_type_ == TILEDB_ANY) {
+        // No batches were appended
+        data_type_ = TILEDB_FLOAT32;
+    }
+
+    LOG_DEBUG(fmt::format(
+        "[CompressedSparseMatrix] Compressing {} cells from {} batches into "
+        "{} {}x{}",
+        nnz_,
+        batches_.size(),
+        csr_ ? "CSR" : "CSC",
+        num_rows_,
+        num_cols_));
+
+    // Move bits of the values: only their size matters
+    switch (tiledb::impl::type_size(data_type_)) {
+        case 1:
+            compress_as<uint8_t>();
+            break;
+        case 2:
+            compress_as<uint16_t>();
+            break;
+        case 4:
+            compress_as<uint32_t>();
+            break;
+        case 8:
+            compress_as<uint64_t>();
+            break;
+        default:
+            throw TileDBSOMAError(fmt::format(
+                "[CompressedSparseMatrix] Unsupported '{}' type {}",
+                DATA,
+                tiledb::impl::type_to_str(data_type_)));
+    }
+
+    batches_.clear();
+    compressed_ = true;
+}
+
+std::vector<int64_t>& CompressedSparseMatrix::indptr() {
+    check_compressed();
+    return indptr_;
+}
+
+std::vector<int64_t>& CompressedSparseMatrix::indices() {
+    check_compressed();
+    return indices_;
+}
+
+std::vector<std::byte>& CompressedSparseMatrix::data() {
+    check_compressed();
+    return data_;
+}
+
+void CompressedSparseMatrix::check_compressed() const {
+    if (!compressed_) {
+        throw TileDBSOMAError(
+            "[CompressedSparseMatrix] Matrix is not compressed: call "
+            "compress() first");
+    }
+}
+
+template <typename T>
+void CompressedSparseMatrix::compress_as() {
+    uint64_t num_major = csr_ ? num_rows_ : num_cols_;
+
+    // Split the cells of all batches into contiguous ranges, one per task.
+    // Each task counts its cells per row, so tasks are limited to keep the
+    // counts of all tasks within about nnz entries.
+    size_t concurrency = ctx_ == nullptr || ctx_->thread_pool() == nullptr ?
+                             1 :
+                             ctx_->thread_pool()->concurrency_level();
+    size_t num_tasks = std::max<size_t>(
+        1,
+        std::min<size_t>(
+            {concurrency,
+             nnz_ / MIN_CELLS_PER_TASK,
+             nnz_ / std::max<uint64_t>(num_major, 1)}));
+    std::vector<uint64_t> batch_starts{0};
+    for (auto& batch : batches_) {
+        batch_starts.push_back(batch_starts.back() + batch.rows.size());
+    }
+    auto for_each_cell = [&](size_t task, auto&& fn) {
+        uint64_t cell = nnz_ * task / num_tasks;
+        uint64_t end = nnz_ * (task + 1) / num_tasks;
+        size_t b = std::upper_bound(
+                       batch_starts.begin(), batch_starts.end(), cell) -
+                   batch_starts.begin() - 1;
+        for (; cell < end; b++) {
+            auto last = std::min(end, batch_starts[b + 1]);
+            for (auto i = cell - batch_starts[b]; i < last - batch_starts[b];
+                 i++) {
+                fn(batches_[b], i);
+            }
+            cell = last;
+        }
+    };
+
+    // Count the cells of each row (CSR) or column (CSC) per task
+    std::vector<std::vector<int64_t>> cursors(
+        num_tasks, std::vector<int64_t>(num_major, 0));
+    parallel_for(num_tasks, [&](size_t t) {
+        auto& counts = cursors[t];
+        for_each_cell(t, [&](const Batch& batch, size_t i) {
+            counts[(csr_ ? batch.rows : batch.cols)[i]]++;
+        });
+    });
+
+    // Prefix sum of the counts: row m starts at indptr_[m], and the cells of
+    // task t in row m start at cursors[t][m]
+    int64_t offset = 0;
+    for (uint64_t m = 0; m < num_major; m++) {
+        indptr_[m] = offset;
+        for (auto& counts : cursors) {
+            auto count = counts[m];
+            counts[m] = offset;
+            offset += count;
+        }
+    }
+    indptr_[num_major] = offset;
+
+    // Scatter the cells to their rows. Cells of a row keep the order in
+    // which they were appended.
+    indices_.resize(nnz_);
+    data_.resize(nnz_ * sizeof(T));
+    auto values = reinterpret_cast<T*>(data_.data());
+    parallel_for(num_tasks, [&](size_t t) {
+        auto& cursor = cursors[t];
+        for_each_cell(t, [&](const Batch& batch, size_t i) {
+            auto major = (csr_ ? batch.rows : batch.cols)[i];
+            auto pos = cursor[major]++;
+            indices_[pos] = (csr_ ? batch.cols : batch.rows)[i];
+            values[pos] = reinterpret_cast<const T*>(batch.data.data())[i];
+        });
+    });
+
+    // Sort the cells of each row by their minor coordinate, splitting the rows
+    // into tasks of about the same number of cells
+    std::vector<std::pair<uint64_t, uint64_t>> row_chunks;
+    uint64_t first_row = 0;
+    for (uint64_t m = 0; m < num_major; m++) {
+        if (static_cast<size_t>(indptr_[m + 1] - indptr_[first_row]) >=
+                MIN_CELLS_PER_TASK ||
+            m + 1 == num_major) {
+            row_chunks.emplace_back(first_row, m + 1);
+            first_row = m + 1;
+        }
+    }
+    parallel_for(row_chunks.size(), [&](size_t c) {
+        std::vector<std::pair<int64_t, T>> cells;
+        for (auto m = row_chunks[c].first; m < row_chunks[c].second; m++) {
+            auto start = indptr_[m];
+            auto end = indptr_[m + 1];
+            if (std::is_sorted(
+                    indices_.begin() + start, indices_.begin() + end)) {
+                continue;
+            }
+            cells.clear();
+            for (auto i = start; i < end; i++) {
+                cells.emplace_back(indices_[i], values[i]);
+            }
+            std::sort(
+                cells.begin(), cells.end(), [](const auto& a, const auto& b) {
+                    return a.first < b.first;
+                });
+            for (auto i = start; i < end; i++) {
+                indices_[i] = cells[i - start].first;
+                values[i] = cells[i - start].second;
+            }
+        }
+    });
+}
+
+void CompressedSparseMatrix::parallel_for(
+    size_t n, const std::function<void(size_t)>& fn) {
+    if (n <= 1 || ctx_ == nullptr || ctx_->thread_pool() == nullptr ||
+        ctx_->thread_pool()->concurrency_level() == 1) {
+        for (size_t i = 0; i < n; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    auto& thread_pool = ctx_->thread_pool();
+    std::vector<ThreadPool::Task> tasks;
+    for (size_t i = 0; i < n; i++) {
+        tasks.emplace_back(thread_pool->execute([&fn, i]() {
+            fn(i);
+            return Status::Ok();
+        }));
+    }
+    thread_pool->wait_all(tasks);
+}
+
+}  // namespace tiledbsoma
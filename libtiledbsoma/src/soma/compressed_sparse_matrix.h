@@ -0,0 +1,267 @@
+/**
+ * @file   compressed_sparse_matrix.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the CompressedSparseMatrix class.
+ */
+
+#ifndef COMPRESSED_SPARSE_MATRIX
+#define COMPRESSED_SPARSE_MATRIX
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tiledb/tiledb>
+
+#include "array_buffers.h"
+
+namespace tiledbsoma {
+
+class IntIndexer;
+class SOMAContext;
+
+using namespace tiledb;
+
+/**
+ * @brief Builds a compressed sparse matrix (CSR or CSC) from the batches of
+ * COO results read from a 2D SOMASparseNDArray.
+ *
+ * The cells of each appended batch are copied into compact vectors, without
+ * concatenating the batches. The coordinates are optionally reindexed with an
+ * IntIndexer per axis. `compress` then places every cell in its row (CSR) or
+ * column (CSC) with a counting sort, and sorts the minor coordinates within
+ * each row or column. Both run in parallel on the SOMAContext thread pool.
+ *
+ * An example use model:
+ *
+ *   CompressedSparseMatrix matrix(ctx, num_rows, num_cols);
+ *   while (auto batch = sparse_array->read_next()) {
+ *       matrix.append(*batch);
+ *   }
+ *   matrix.compress();
+ *   // use matrix.indptr(), matrix.indices(), matrix.data()
+ */
+class CompressedSparseMatrix {
+   public:
+    inline static const std::string DIM_0 = "soma_dim_0";
+    inline static const std::string DIM_1 = "soma_dim_1";
+    inline static const std::string DATA = "soma_data";
+
+    /**
+     * @brief Construct a new CompressedSparseMatrix object.
+     *
+     * @param ctx SOMAContext providing the thread pool
+     * @param num_rows Number of rows
+     * @param num_cols Number of columns
+     * @param csr Compress rows (CSR) if true, columns (CSC) otherwise
+     * @param row_indexer If set, maps soma_dim_0 values to row indexes
+     * @param col_indexer If set, maps soma_dim_1 values to column indexes
+     */
+    CompressedSparseMatrix(
+        std::shared_ptr<SOMAContext> ctx,
+        uint64_t num_rows,
+        uint64_t num_cols,
+        bool csr = true,
+        std::shared_ptr<IntIndexer> row_indexer = nullptr,
+        std::shared_ptr<IntIndexer> col_indexer = nullptr);
+
+    CompressedSparseMatrix() = delete;
+    CompressedSparseMatrix(const CompressedSparseMatrix&) = delete;
+    CompressedSparseMatrix(CompressedSparseMatrix&&) = default;
+    ~CompressedSparseMatrix() = default;
+
+    /**
+     * @brief Append a batch of results with soma_dim_0, soma_dim_1 and
+     * soma_data columns. Only the cells of the batch are copied, so its
+     * buffers can be reused by the next read. No more batches can be
+     * appended after `compress` is called. Throws if a coordinate is outside
+     * of the matrix shape or missing from an indexer.
+     *
+     * @param batch Results from SOMAArray::read_next
+     */
+    void append(std::shared_ptr<ArrayBuffers> batch);
+
+    /**
+     * @brief Build indptr, indices and data from the appended batches, and
+     * release the batches.
+     */
+    void compress();
+
+    /**
+     * @brief Return the number of rows.
+     *
+     * @return uint64_t
+     */
+    uint64_t num_rows() const {
+        return num_rows_;
+    }
+
+    /**
+     * @brief Return the number of columns.
+     *
+     * @return uint64_t
+     */
+    uint64_t num_cols() const {
+        return num_cols_;
+    }
+
+    /**
+     * @brief Return true if rows are compressed (CSR), false for columns
+     * (CSC).
+     *
+     * @return bool
+     */
+    bool is_csr() const {
+        return csr_;
+    }
+
+    /**
+     * @brief Return the number of cells appended.
+     *
+     * @return uint64_t
+     */
+    uint64_t nnz() const {
+        return nnz_;
+    }
+
+    /**
+     * @brief Return the offsets of each row (CSR) or column (CSC) in
+     * `indices` and `data`, with one extra offset at the end. Throws if
+     * `compress` has not been called.
+     *
+     * @return std::vector<int64_t>&
+     */
+    std::vector<int64_t>& indptr();
+
+    /**
+     * @brief Return the column (CSR) or row (CSC) index of each cell. Throws
+     * if `compress` has not been called.
+     *
+     * @return std::vector<int64_t>&
+     */
+    std::vector<int64_t>& indices();
+
+    /**
+     * @brief Return the value of each cell, of type `data_type()`. Throws if
+     * `compress` has not been called.
+     *
+     * @return std::vector<std::byte>&
+     */
+    std::vector<std::byte>& data();
+
+    /**
+     * @brief Return the TileDB datatype of the values.
+     *
+     * @return tiledb_datatype_t
+     */
+    tiledb_datatype_t data_type() const {
+        return data_type_;
+    }
+
+   private:
+    // A batch of COO cells, with coordinates in matrix rows and columns
+    struct Batch {
+        std::vector<int64_t> rows;
+        std::vector<int64_t> cols;
+        std::vector<std::byte> data;
+    };
+
+    /**
+     * @brief Copy coordinates of a batch into matrix rows or columns, using
+     * the indexer if set, and check them against the matrix shape.
+     *
+     * @param coords Coordinates of the batch
+     * @param indexer Indexer of the axis, or nullptr
+     * @param size Size of the axis
+     * @return std::vector<int64_t> Coordinates in the matrix
+     */
+    std::vector<int64_t> to_matrix_coords(
+        tcb::span<int64_t> coords,
+        const std::shared_ptr<IntIndexer>& indexer,
+        uint64_t size);
+
+    /**
+     * @brief Throw if `compress` has not been called.
+     */
+    void check_compressed() const;
+
+    /**
+     * @brief Scatter the cells into their rows or columns and sort them.
+     *
+     * @tparam T Unsigned integer type with the size of a value
+     */
+    template <typename T>
+    void compress_as();
+
+    /**
+     * @brief Call `fn(i)` for `i` in [0, n), on the thread pool if the
+     * context has one.
+     *
+     * @param n Number of tasks
+     * @param fn Task function
+     */
+    void parallel_for(size_t n, const std::function<void(size_t)>& fn);
+
+    // SOMA context
+    std::shared_ptr<SOMAContext> ctx_;
+
+    // Matrix shape
+    uint64_t num_rows_;
+    uint64_t num_cols_;
+
+    // Compress rows if true, columns otherwise
+    bool csr_;
+
+    // Indexers mapping coordinates to rows and columns, if set
+    std::shared_ptr<IntIndexer> row_indexer_;
+    std::shared_ptr<IntIndexer> col_indexer_;
+
+    // Batches appended since the last `compress`
+    std::vector<Batch> batches_;
+
+    // Number of cells appended
+    uint64_t nnz_ = 0;
+
+    // True once `compress` has been called
+    bool compressed_ = false;
+
+    // Type of the values, set by the first batch
+    tiledb_datatype_t data_type_ = TILEDB_ANY;
+
+    // Compressed matrix
+    std::vector<int64_t> indptr_;
+    std::vector<int64_t> indices_;
+    std::vector<std::byte> data_;
+};
+
+}  // namespace tiledbsoma
+
+#endif  // COMPRESSED_SPARSE_MATRIX
@@ -40,6 +40,14 @@ enum class OpenMode { read = 0, write };
  * order */
 enum class ResultOrder { automatic = 0, rowmajor, colmajor };
 
+/** Defines how a list of points selected on a dimension is added to the
+ * query: one range per point, sorted points merged into ranges, or one
+ * bounding range filtered down to the points by a query condition */
+enum class PointSelection { automatic = 0, points, ranges, bounding_range };
+
+/** Defines the reduction computed over a column by SOMAArray::aggregate */
+enum class AggregateOp { sum = 0, mean, min, max, count };
+
 /** Defines whether the SOMAGroup URI is absolute or relative */
 enum class URIType { automatic = 0, absolute, relative };
 
@@ -31,6 +31,7 @@
  */
 
 #include "managed_query.h"
+#include <atomic>
 #include <tiledb/array_experimental.h>
 #include <tiledb/attribute_experimental.h>
 #include "../utils/logger.h"
@@ -51,6 +52,10 @@ ManagedQuery::ManagedQuery(
     , ctx_(ctx)
     , name_(name)
     , schema_(std::make_shared<ArraySchema>(array->schema())) {
+    auto config = ctx_->config();
+    if (config.contains(CONFIG_KEY_PREFETCH)) {
+        prefetch_ = config.get(CONFIG_KEY_PREFETCH) == "true";
+    }
     reset();
 }
 
@@ -58,20 +63,84 @@ void ManagedQuery::close() {
     if (query_future_.valid()) {
         query_future_.get();
     }
+    prefetch_pending_ = false;
+    next_buffers_.reset();
+    buffer_pool_.clear();
+    enumerations_.clear();
+    enumerations_loaded_ = false;
     array_->close();
 }
 
 void ManagedQuery::reset() {
+    // Do not destroy the query while a prefetched submit is using it
+    wait_for_submit();
+
     query_ = std::make_unique<Query>(*ctx_, *array_);
     subarray_ = std::make_unique<Subarray>(*ctx_, *array_);
 
     subarray_range_set_ = false;
     subarray_range_empty_ = {};
+    selected_points_.clear();
+    condition_.reset();
+    point_filters_.clear();
     columns_.clear();
     results_complete_ = true;
     total_num_cells_ = 0;
     buffers_.reset();
+    batch_rows_ = std::nullopt;
+    column_alloc_sizes_.clear();
     query_submitted_ = false;
+    prefetch_pending_ = false;
+    next_buffers_.reset();
+    buffer_pool_.clear();
+}
+
+std::vector<std::unique_ptr<ManagedQuery>> ManagedQuery::partition(
+    size_t num_partitions) {
+    if (array_->schema().array_type() != TILEDB_SPARSE || is_empty_query()) {
+        return {};
+    }
+
+    // The partitions split the ranges of the selected points
+    apply_point_selection();
+
+    auto dim = array_->schema().domain().dimension(0);
+    switch (dim.type()) {
+        case TILEDB_INT8:
+            return partition_queries(partition_ranges<int8_t>(num_partitions));
+        case TILEDB_UINT8:
+            return partition_queries(partition_ranges<uint8_t>(num_partitions));
+        case TILEDB_INT16:
+            return partition_queries(partition_ranges<int16_t>(num_partitions));
+        case TILEDB_UINT16:
+            return partition_queries(
+                partition_ranges<uint16_t>(num_partitions));
+        case TILEDB_INT32:
+            return partition_queries(partition_ranges<int32_t>(num_partitions));
+        case TILEDB_UINT32:
+            return partition_queries(
+                partition_ranges<uint32_t>(num_partitions));
+        case TILEDB_INT64:
+            return partition_queries(partition_ranges<int64_t>(num_partitions));
+        case TILEDB_UINT64:
+            return partition_queries(
+                partition_ranges<uint64_t>(num_partitions));
+        default:
+            LOG_DEBUG(fmt::format(
+                "[ManagedQuery] [{}] Cannot partition on dimension '{}' of "
+                "type {}",
+                name_,
+                dim.name(),
+                tiledb::impl::type_to_str(dim.type())));
+            return {};
+    }
+}
+
+void ManagedQuery::apply_point_selection() {
+    for (auto& [dim, points] : selected_points_) {
+        points->apply(*this, dim);
+    }
+    selected_points_.clear();
 }
 
 void ManagedQuery::select_columns(
@@ -219,6 +288,11 @@ void ManagedQuery::set_column_data(
 }
 
 void ManagedQuery::setup_read() {
+    // The buffers for the next batch were set up and submitted by results()
+    if (prefetch_pending_) {
+        return;
+    }
+
     // If the query is complete, return so we do not submit it again
     auto status = query_->query_status();
     if (status == Query::Status::COMPLETE) {
@@ -227,6 +301,8 @@ void ManagedQuery::setup_read() {
 
     // If the query is uninitialized, set the subarray for the query
     if (status == Query::Status::UNINITIALIZED) {
+        apply_point_selection();
+
         // Dense array must have a subarray set. If the array is dense and no
         // ranges have been set, add a range for the array's entire non-empty
         // domain on dimension 0.
@@ -245,6 +321,15 @@ void ManagedQuery::setup_read() {
 
         // Set the subarray for range slicing
         query_->set_subarray(*subarray_);
+
+        // Filter bounding ranges added by select_points down to the points
+        if (!point_filters_.empty()) {
+            std::optional<QueryCondition> qc = condition_;
+            for (auto& [dim, filter] : point_filters_) {
+                qc = qc ? qc->combine(filter, TILEDB_AND) : filter;
+            }
+            query_->set_condition(*qc);
+        }
     }
 
     // If no columns were selected, select all columns.
@@ -261,15 +346,10 @@ void ManagedQuery::setup_read() {
         }
     }
 
-    // Allocate and attach buffers
-    LOG_TRACE("[ManagedQuery] allocate new buffers");
-    buffers_ = std::make_shared<ArrayBuffers>();
-    for (auto& name : columns_) {
-        LOG_DEBUG(fmt::format(
-            "[ManagedQuery] [{}] Adding buffer for column '{}'", name_, name));
-        buffers_->emplace(name, ColumnBuffer::create(array_, name));
-        buffers_->at(name)->attach(*query_);
-    }
+    // Allocate and attach buffers. Release the previous batch first, so its
+    // buffers can be reused if the caller is done with them.
+    buffers_.reset();
+    buffers_ = alloc_buffers();
 }
 
 void ManagedQuery::submit_write(bool sort_coords) {
@@ -288,8 +368,34 @@ void ManagedQuery::submit_write(bool sort_coords) {
     }
 }
 
-void ManagedQuery::submit_read() {
+void ManagedQuery::submit_global_order_batch() {
+    if (array_->schema().array_type() != TILEDB_SPARSE) {
+        throw TileDBSOMAError(
+            "[ManagedQuery] global order writes are only supported for sparse "
+            "arrays");
+    }
+    if (query_->query_layout() != TILEDB_GLOBAL_ORDER) {
+        query_->set_layout(TILEDB_GLOBAL_ORDER);
+    }
+    query_->submit();
+}
+
+void ManagedQuery::finalize_write() {
+    query_->finalize();
+}
+
+void ManagedQuery::submit_read(bool async) {
+    if (prefetch_pending_) {
+        return;
+    }
     query_submitted_ = true;
+    if (!async) {
+        query_->submit();
+        std::promise<void> submitted;
+        submitted.set_value();
+        query_future_ = submitted.get_future();
+        return;
+    }
     query_future_ = std::async(std::launch::async, [&]() {
         LOG_DEBUG("[ManagedQuery] submit thread start");
         query_->submit();
@@ -310,6 +416,12 @@ std::shared_ptr<ArrayBuffers> ManagedQuery::results() {
             fmt::format("[ManagedQuery] [{}] 'query_future_' invalid", name_));
     }
 
+    // The prefetched batch becomes the current batch
+    if (prefetch_pending_) {
+        buffers_ = std::move(next_buffers_);
+        prefetch_pending_ = false;
+    }
+
     auto status = query_->query_status();
 
     if (status == Query::Status::FAILED) {
@@ -317,6 +429,61 @@ std::shared_ptr<ArrayBuffers> ManagedQuery::results() {
             fmt::format("[ManagedQuery] [{}] Query FAILED", name_));
     }
 
+    // Update ColumnBuffer size to match query results
+    size_t num_cells = update_buffer_sizes();
+
+    // If not even one cell fit in the buffers, grow them and retry the
+    // query until a cell fits or the buffers reach their maximum size.
+    while (status == Query::Status::INCOMPLETE && !num_cells) {
+        if (!expand_buffers()) {
+            throw TileDBSOMAError(fmt::format(
+                "[ManagedQuery] [{}] Buffers are too small. Increase "
+                "'soma.max_buffer_bytes' (currently {} bytes)",
+                name_,
+                ColumnBuffer::max_alloc_bytes(ctx_->config())));
+        }
+
+        LOG_DEBUG(fmt::format(
+            "[ManagedQuery] [{}] Resubmitting query with larger buffers",
+            name_));
+        query_->submit();
+        status = query_->query_status();
+        if (status == Query::Status::FAILED) {
+            throw TileDBSOMAError(
+                fmt::format("[ManagedQuery] [{}] Query FAILED", name_));
+        }
+        num_cells = update_buffer_sizes();
+    }
+
+    // If fewer cells than the batch size were read, continue the query into
+    // the unused part of the buffers to coalesce small reads into one batch.
+    while (batch_rows_ && status == Query::Status::INCOMPLETE &&
+           num_cells < *batch_rows_) {
+        for (auto& name : buffers_->names()) {
+            buffers_->at(name)->attach_remaining(*query_);
+        }
+        query_->submit();
+        status = query_->query_status();
+        if (status == Query::Status::FAILED) {
+            throw TileDBSOMAError(
+                fmt::format("[ManagedQuery] [{}] Query FAILED", name_));
+        }
+
+        size_t num_appended = 0;
+        for (auto& name : buffers_->names()) {
+            num_appended = buffers_->at(name)->update_size_appended(*query_);
+        }
+        LOG_DEBUG(fmt::format(
+            "[ManagedQuery] [{}] Appended {} cells to batch of {} cells",
+            name_,
+            num_appended,
+            num_cells));
+        if (num_appended == 0) {
+            // The buffers are full
+            break;
+        }
+        num_cells += num_appended;
+    }
     // If the query was ever incomplete, the result buffers contents are not
     // complete.
     if (status == Query::Status::INCOMPLETE) {
@@ -325,44 +492,406 @@ std::shared_ptr<ArrayBuffers> ManagedQuery::results() {
         results_complete_ = true;
     }
 
-    // Update ColumnBuffer size to match query results
+    total_num_cells_ += num_cells;
+
+    // Attach the enumeration vectors, which are loaded once per open array
+    for (auto& [attrname, enums] : enumerations()) {
+        if (buffers_->contains(attrname)) {
+            buffers_->at(attrname)->add_enumeration(enums);
+        }
+    }
+
+    // Submit the query for the next batch into a new set of buffers while
+    // the caller processes this one. The current buffers may still be
+    // referenced by Arrow arrays, so they are never reused here.
+    if (prefetch_ && status == Query::Status::INCOMPLETE) {
+        LOG_DEBUG(
+            fmt::format("[ManagedQuery] [{}] Prefetching next batch", name_));
+        next_buffers_ = alloc_buffers();
+        prefetch_pending_ = true;
+        query_future_ = std::async(std::launch::async, [&]() {
+            LOG_DEBUG("[ManagedQuery] prefetch thread start");
+            query_->submit();
+            LOG_DEBUG("[ManagedQuery] prefetch thread done");
+        });
+    }
+
+    return buffers_;
+}
+
+std::map<std::string, size_t> ManagedQuery::buffer_sizes() {
+    std::map<std::string, size_t> sizes;
+    if (buffers_ == nullptr) {
+        return sizes;
+    }
+    for (auto& name : buffers_->names()) {
+        sizes[name] = buffers_->at(name)->data_capacity();
+    }
+    return sizes;
+}
+
+size_t ManagedQuery::update_buffer_sizes() {
     size_t num_cells = 0;
     for (auto& name : buffers_->names()) {
         num_cells = buffers_->at(name)->update_size(*query_);
         LOG_DEBUG(fmt::format(
             "[ManagedQuery] [{}] Buffer {} cells={}", name_, name, num_cells));
     }
-    total_num_cells_ += num_cells;
+    return num_cells;
+}
 
-    // TODO: retry the query with larger buffers
-    if (status == Query::Status::INCOMPLETE && !num_cells) {
-        throw TileDBSOMAError(
-            fmt::format("[ManagedQuery] [{}] Buffers are too small.", name_));
+bool ManagedQuery::expand_buffers() {
+    auto max_bytes = ColumnBuffer::max_alloc_bytes(ctx_->config());
+    bool expanded = false;
+    for (auto& name : buffers_->names()) {
+        auto buffer = buffers_->at(name);
+        if (buffer->expand(max_bytes)) {
+            expanded = true;
+            column_alloc_sizes_[name] = {
+                buffer->cell_capacity(), buffer->data_capacity()};
+        }
+        buffer->attach(*query_);
+    }
+
+    if (expanded) {
+        std::string sizes;
+        for (auto& [name, num_bytes] : buffer_sizes()) {
+            sizes += fmt::format(
+                "{}{}={}", sizes.empty() ? "" : ", ", name, num_bytes);
+        }
+        LOG_INFO(fmt::format(
+            "[ManagedQuery] [{}] A cell did not fit in the read buffers; "
+            "expanded buffers to [{}] bytes",
+            name_,
+            sizes));
+    }
+    return expanded;
+}
+
+std::shared_ptr<ArrayBuffers> ManagedQuery::alloc_buffers() {
+    if (column_alloc_sizes_.empty()) {
+        set_alloc_sizes();
+    }
+
+    if (auto buffers = reuse_buffers()) {
+        LOG_DEBUG(
+            fmt::format("[ManagedQuery] [{}] Reusing pooled buffers", name_));
+        for (auto& name : buffers->names()) {
+            buffers->at(name)->clear();
+            buffers->at(name)->attach(*query_);
+        }
+        return buffers;
+    }
+
+    LOG_TRACE("[ManagedQuery] allocate new buffers");
+    auto buffers = std::make_shared<ArrayBuffers>();
+    for (auto& name : columns_) {
+        LOG_DEBUG(fmt::format(
+            "[ManagedQuery] [{}] Adding buffer for column '{}'", name_, name));
+        std::optional<size_t> num_cells = std::nullopt;
+        std::optional<size_t> num_bytes = std::nullopt;
+        if (auto it = column_alloc_sizes_.find(name);
+            it != column_alloc_sizes_.end()) {
+            num_cells = it->second.first;
+            num_bytes = it->second.second;
+        }
+        buffers->emplace(
+            name, ColumnBuffer::create(array_, name, num_cells, num_bytes));
+        buffers->at(name)->attach(*query_);
+    }
+
+    // Keep the most recent buffers for reuse. Buffers dropped from the pool
+    // are freed when the caller releases them.
+    if (buffer_pool_.size() >= MAX_POOLED_BUFFERS) {
+        buffer_pool_.erase(buffer_pool_.begin());
+    }
+    buffer_pool_.push_back(buffers);
+    return buffers;
+}
+
+std::shared_ptr<ArrayBuffers> ManagedQuery::reuse_buffers() {
+    for (auto& buffers : buffer_pool_) {
+        // Buffers held by the caller, by an unreleased Arrow array or by
+        // this query (current or prefetched batch) are in use
+        if (buffers.use_count() > 1 || buffers->in_use()) {
+            continue;
+        }
+
+        // Buffers expanded by a retry may be smaller than later allocations
+        bool fits = buffers->names() == columns_;
+        for (auto& [name, sizes] : column_alloc_sizes_) {
+            if (!fits || !buffers->contains(name)) {
+                fits = false;
+                break;
+            }
+            auto buffer = buffers->at(name);
+            fits = buffer->data_capacity() >= sizes.second &&
+                   (!buffer->is_var() ||
+                    buffer->cell_capacity() >= sizes.first);
+        }
+        if (fits) {
+            // Synchronize with the thread that released the last reference
+            // before writing new results into the buffers
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return buffers;
+        }
+    }
+    return nullptr;
+}
+
+void ManagedQuery::set_alloc_sizes() {
+    auto budget = ColumnBuffer::read_budget_bytes(ctx_->config());
+    if (!budget && !batch_rows_) {
+        // Allocate `soma.init_buffer_bytes` for each column
+        return;
+    }
+    auto max_bytes = ColumnBuffer::max_alloc_bytes(ctx_->config());
+
+    // Data bytes per cell for each column, and the total bytes per row
+    // including offsets and validity
+    std::map<std::string, size_t> data_cell_bytes;
+    size_t row_bytes = 0;
+    for (auto& name : columns_) {
+        tiledb_datatype_t type;
+        bool is_var;
+        bool is_nullable;
+        if (schema_->has_attribute(name)) {
+            auto attr = schema_->attribute(name);
+            type = attr.type();
+            is_var = attr.cell_val_num() == TILEDB_VAR_NUM;
+            is_nullable = attr.nullable();
+        } else {
+            auto dim = schema_->domain().dimension(name);
+            type = dim.type();
+            is_var = dim.cell_val_num() == TILEDB_VAR_NUM ||
+                     type == TILEDB_STRING_ASCII || type == TILEDB_STRING_UTF8;
+            is_nullable = false;
+        }
+
+        auto cell_bytes = is_var ?
+                              estimate_var_cell_bytes(name, is_nullable) :
+                              tiledb::impl::type_size(type);
+        data_cell_bytes[name] = cell_bytes;
+        row_bytes += cell_bytes + (is_var ? sizeof(uint64_t) : 0) +
+                     (is_nullable ? sizeof(uint8_t) : 0);
+    }
+    if (row_bytes == 0) {
+        return;
+    }
+
+    size_t num_cells = budget ? std::max<size_t>(*budget / row_bytes, 1) :
+                                std::numeric_limits<size_t>::max();
+    if (batch_rows_) {
+        num_cells = std::min(num_cells, *batch_rows_);
+    }
+    num_cells = std::min(num_cells, std::max<size_t>(max_bytes / row_bytes, 1));
+    for (auto& [name, cell_bytes] : data_cell_bytes) {
+        // Cap columns with very large cells, relying on retries to grow them
+        // further if a single cell does not fit.
+        auto num_bytes = std::min(num_cells * cell_bytes, max_bytes);
+        column_alloc_sizes_[name] = {num_cells, num_bytes};
+    }
+
+    LOG_DEBUG(fmt::format(
+        "[ManagedQuery] [{}] Read budget {} bytes, batch size {} rows, {} "
+        "bytes per row, {} cells per buffer",
+        name_,
+        budget ? std::to_string(*budget) : "none",
+        batch_rows_ ? std::to_string(*batch_rows_) : "auto",
+        row_bytes,
+        num_cells));
+}
+
+size_t ManagedQuery::estimate_var_cell_bytes(
+    const std::string& name, bool is_nullable) {
+    try {
+        uint64_t offsets_bytes;
+        uint64_t data_bytes;
+        if (is_nullable) {
+            auto est = query_->est_result_size_var_nullable(name);
+            offsets_bytes = est[0];
+            data_bytes = est[1];
+        } else {
+            auto est = query_->est_result_size_var(name);
+            offsets_bytes = est[0];
+            data_bytes = est[1];
+        }
+        auto est_cells = offsets_bytes / sizeof(uint64_t);
+        if (est_cells > 0 && data_bytes > 0) {
+            return std::max<size_t>(data_bytes / est_cells, 1);
+        }
+    } catch (const std::exception& e) {
+        LOG_DEBUG(fmt::format(
+            "[ManagedQuery] [{}] Cannot estimate result size of '{}': {}",
+            name_,
+            name,
+            e.what()));
+    }
+    return DEFAULT_VAR_CELL_BYTES;
+}
+
+const std::map<std::string, std::shared_ptr<EnumerationBuffers>>&
+ManagedQuery::enumerations() {
+    if (enumerations_loaded_) {
+        return enumerations_;
     }
 
     // Visit all attributes and retrieve enumeration vectors
-    auto attribute_map = schema_->attributes();
-    for (auto& nmit : attribute_map) {
-        auto attrname = nmit.first;
-        auto attribute = nmit.second;
+    for (auto& [attrname, attribute] : schema_->attributes()) {
         auto enumname = AttributeExperimental::get_enumeration_name(
             *ctx_, attribute);
         if (enumname != std::nullopt) {
             auto enumeration = ArrayExperimental::get_enumeration(
                 *ctx_, *array_, enumname.value());
-            auto enumvec = enumeration.as_vector<std::string>();
-            if (!buffers_->contains(attrname)) {
-                continue;
-            }
-            auto colbuf = buffers_->at(attrname);
-            colbuf->add_enumeration(enumvec);
+            enumerations_[attrname] = std::make_shared<EnumerationBuffers>(
+                enumeration.as_vector<std::string>());
             LOG_DEBUG(fmt::format(
                 "[ManagedQuery] got Enumeration '{}' for attribute '{}'",
                 enumname.value(),
                 attrname));
         }
     }
-    return buffers_;
+    enumerations_loaded_ = true;
+    return enumerations_;
+}
+
+template <typename T>
+std::vector<std::vector<std::pair<T, T>>> ManagedQuery::partition_ranges(
+    size_t num_partitions) {
+    std::vector<std::vector<std::pair<T, T>>> partitions;
+
+    // Ranges selected on the first dimension, clipped to its non-empty domain
+    auto [ned_start, ned_end] = array_->non_empty_domain<T>(0);
+    std::vector<std::pair<T, T>> ranges;
+    auto dim_name = array_->schema().domain().dimension(0).name();
+    if (subarray_range_empty_.count(dim_name)) {
+        for (uint64_t i = 0; i < subarray_->range_num(0); i++) {
+            auto range = subarray_->range<T>(0, i);
+            auto start = std::max(range[0], ned_start);
+            auto end = std::min(range[1], ned_end);
+            if (start <= end) {
+                ranges.emplace_back(start, end);
+            }
+        }
+    } else {
+        ranges.emplace_back(ned_start, ned_end);
+    }
+    if (ranges.empty() || num_partitions == 0) {
+        return partitions;
+    }
+
+    T lo = ranges.front().first;
+    T hi = ranges.front().second;
+    for (auto& [start, end] : ranges) {
+        lo = std::min(lo, start);
+        hi = std::max(hi, end);
+    }
+
+    // Split [lo, hi] into spans that differ by at most one cell. Offsets are
+    // computed with unsigned arithmetic so that signed spans do not overflow.
+    uint64_t span = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    if (span < num_partitions) {
+        num_partitions = span + 1;
+    }
+    uint64_t step = span / num_partitions;
+    uint64_t remainder = span % num_partitions;
+    auto partition_start = [&](size_t p) {
+        return static_cast<T>(
+            static_cast<uint64_t>(lo) + p * step +
+            std::min<uint64_t>(p, remainder));
+    };
+
+    for (size_t p = 0; p < num_partitions; p++) {
+        T start = partition_start(p);
+        T end = p + 1 < num_partitions ?
+                    static_cast<T>(partition_start(p + 1) - 1) :
+                    hi;
+
+        std::vector<std::pair<T, T>> partition;
+        for (auto& [range_start, range_end] : ranges) {
+            if (range_start <= end && range_end >= start) {
+                partition.emplace_back(
+                    std::max(range_start, start), std::min(range_end, end));
+            }
+        }
+        if (!partition.empty()) {
+            partitions.push_back(std::move(partition));
+        }
+    }
+    return partitions;
+}
+
+template <typename T>
+std::vector<std::unique_ptr<ManagedQuery>> ManagedQuery::partition_queries(
+    const std::vector<std::vector<std::pair<T, T>>>& partition_ranges) {
+    std::vector<std::unique_ptr<ManagedQuery>> queries;
+    auto domain = array_->schema().domain();
+    auto c_ctx = ctx_->ptr().get();
+
+    for (size_t p = 0; p < partition_ranges.size(); p++) {
+        auto mq = std::make_unique<ManagedQuery>(
+            array_, ctx_, fmt::format("{}[{}]", name_, p));
+        mq->columns_ = columns_;
+        mq->set_layout(query_->query_layout());
+        if (condition_) {
+            mq->set_condition(*condition_);
+        }
+        mq->point_filters_ = point_filters_;
+        mq->batch_rows_ = batch_rows_;
+        mq->prefetch_ = prefetch_;
+
+        // Select the same ranges as this query on the other dimensions
+        for (unsigned d = 1; d < domain.ndim(); d++) {
+            auto dim = domain.dimension(d);
+            if (!subarray_range_empty_.count(dim.name())) {
+                continue;
+            }
+            for (uint64_t i = 0; i < subarray_->range_num(d); i++) {
+                if (dim.cell_val_num() == TILEDB_VAR_NUM) {
+                    auto range = subarray_->range(d, i);
+                    mq->subarray_->add_range(d, range[0], range[1]);
+                } else {
+                    const void *start, *end, *stride;
+                    ctx_->handle_error(tiledb_subarray_get_range(
+                        c_ctx,
+                        subarray_->ptr().get(),
+                        d,
+                        i,
+                        &start,
+                        &end,
+                        &stride));
+                    ctx_->handle_error(tiledb_subarray_add_range(
+                        c_ctx,
+                        mq->subarray_->ptr().get(),
+                        d,
+                        start,
+                        end,
+                        nullptr));
+                }
+            }
+        }
+
+        for (auto& [start, end] : partition_ranges[p]) {
+            mq->subarray_->add_range(0, start, end);
+        }
+        mq->subarray_range_set_ = true;
+        mq->subarray_range_empty_ = subarray_range_empty_;
+        mq->subarray_range_empty_[domain.dimension(0).name()] = false;
+
+        queries.push_back(std::move(mq));
+    }
+
+    LOG_DEBUG(fmt::format(
+        "[ManagedQuery] [{}] Partitioned into {} queries",
+        name_,
+        queries.size()));
+    return queries;
+}
+
+void ManagedQuery::wait_for_submit() {
+    if (query_future_.valid()) {
+        query_future_.wait();
+    }
 }
 
 void ManagedQuery::check_column_name(const std::string& name) {
@@ -33,21 +33,42 @@
 #ifndef MANAGED_QUERY_H
 #define MANAGED_QUERY_H
 
+#include <algorithm>
 #include <future>
 #include <stdexcept>  // for windows: error C2039: 'runtime_error': is not a member of 'std'
 #include <unordered_set>
 
 #include <tiledb/tiledb>
+#include <tiledb/tiledb_experimental>
 
 #include "../utils/common.h"
 #include "array_buffers.h"
 #include "column_buffer.h"
+#include "enums.h"
+#include "logger_public.h"
 
 namespace tiledbsoma {
 
 using namespace tiledb;
 
 class ManagedQuery {
+    // Set to "true" to enable read prefetching (see `set_prefetch`)
+    inline static const std::string CONFIG_KEY_PREFETCH = "soma.read_prefetch";
+
+    // Bytes per cell assumed for var-length columns when TileDB cannot
+    // estimate the result size
+    inline static const size_t DEFAULT_VAR_CELL_BYTES = 64;
+
+    // Number of recently allocated result buffers kept for reuse
+    inline static const size_t MAX_POOLED_BUFFERS = 4;
+
+    // Automatic point selection reads one bounding range and filters it when
+    // merging the points would leave more than this many ranges...
+    inline static const size_t BOUNDING_RANGE_MIN_RANGES = 64;
+
+    // ...and the points cover at least this fraction of the bounding range
+    inline static const double BOUNDING_RANGE_MIN_DENSITY = 0.25;
+
    public:
     //===================================================================
     //= public non-static
@@ -77,11 +98,23 @@ class ManagedQuery {
         , subarray_(std::make_unique<Subarray>(*other.ctx_, *other.array_))
         , subarray_range_set_(other.subarray_range_set_)
         , subarray_range_empty_(other.subarray_range_empty_)
+        , point_selection_(other.point_selection_)
+        , selected_points_(std::move(other.selected_points_))
+        , condition_(other.condition_)
+        , point_filters_(other.point_filters_)
         , columns_(other.columns_)
         , results_complete_(other.results_complete_)
         , total_num_cells_(other.total_num_cells_)
         , buffers_(other.buffers_)
-        , query_submitted_(other.query_submitted_) {
+        , batch_rows_(other.batch_rows_)
+        , column_alloc_sizes_(other.column_alloc_sizes_)
+        , query_submitted_(other.query_submitted_)
+        , prefetch_(other.prefetch_)
+        , enumerations_(other.enumerations_)
+        , enumerations_loaded_(other.enumerations_loaded_) {
+        if (condition_) {
+            query_->set_condition(*condition_);
+        }
     }
 
     ~ManagedQuery() = default;
@@ -140,7 +173,8 @@ class ManagedQuery {
     }
 
     /**
-     * @brief Select dimension points to query.
+     * @brief Select dimension points to query, as set by
+     * `set_point_selection`.
      *
      * @tparam T Dimension type
      * @param dim Dimension name
@@ -148,16 +182,12 @@ class ManagedQuery {
      */
     template <typename T>
     void select_points(const std::string& dim, const std::vector<T>& points) {
-        subarray_range_set_ = true;
-        subarray_range_empty_[dim] = true;
-        for (auto& point : points) {
-            subarray_->add_range(dim, point, point);
-            subarray_range_empty_[dim] = false;
-        }
+        add_points(dim, points.data(), points.size());
     }
 
     /**
-     * @brief Select dimension points to query.
+     * @brief Select dimension points to query, as set by
+     * `set_point_selection`.
      *
      * @tparam T Dimension type
      * @param dim Dimension name
@@ -165,12 +195,26 @@ class ManagedQuery {
      */
     template <typename T>
     void select_points(const std::string& dim, const tcb::span<T> points) {
-        subarray_range_set_ = true;
-        subarray_range_empty_[dim] = true;
-        for (auto& point : points) {
-            subarray_->add_range(dim, point, point);
-            subarray_range_empty_[dim] = false;
-        }
+        add_points(dim, points.data(), points.size());
+    }
+
+    /**
+     * @brief Set how points passed to `select_points` are added to the query.
+     *
+     * - `points`: one range per point, in the order given.
+     * - `ranges`: sort and deduplicate the points, merging runs of
+     *   consecutive integers into one range.
+     * - `bounding_range`: one range from the smallest to the largest point,
+     *   filtered down to the points by a query condition. Sparse arrays only.
+     * - `automatic` (default): `points` for dense arrays, which return
+     *   results in the order of the ranges. For sparse arrays,
+     *   `bounding_range` when the points are integers dense enough in their
+     *   span that merging them leaves many ranges, and `ranges` otherwise.
+     *
+     * @param point_selection Point selection strategy
+     */
+    void set_point_selection(PointSelection point_selection) {
+        point_selection_ = point_selection;
     }
 
     /**
@@ -187,6 +231,24 @@ class ManagedQuery {
         subarray_range_empty_[dim] = false;
     }
 
+    /**
+     * @brief Split this read query into disjoint queries along the first
+     * dimension, so that they can be submitted concurrently. The non-empty
+     * domain of the first dimension, clipped to the ranges selected on it, is
+     * split into `num_partitions` equal spans. Each partition selects the
+     * same columns, layout, query condition and ranges on the other
+     * dimensions as this query. Partitions that select no cells are omitted.
+     *
+     * Only sparse arrays with an integer first dimension are partitioned;
+     * otherwise, or if the query selects no cells, an empty vector is
+     * returned.
+     *
+     * @param num_partitions Number of partitions
+     * @return std::vector<std::unique_ptr<ManagedQuery>> Partition queries
+     */
+    std::vector<std::unique_ptr<ManagedQuery>> partition(
+        size_t num_partitions);
+
     /**
      * @brief Set a query condition.
      *
@@ -194,6 +256,7 @@ class ManagedQuery {
      */
     void set_condition(const QueryCondition& qc) {
         query_->set_condition(qc);
+        condition_ = qc;
     }
 
     /**
@@ -234,6 +297,10 @@ class ManagedQuery {
      * @return true if the query is complete, as described above
      */
     bool is_complete(bool query_status_only = false) {
+        // A prefetched submit is still producing the next batch
+        if (prefetch_pending_) {
+            return false;
+        }
         return query_->query_status() == Query::Status::COMPLETE ||
                (!query_status_only && is_empty_query());
     }
@@ -258,6 +325,16 @@ class ManagedQuery {
         return total_num_cells_;
     }
 
+    /**
+     * @brief Return the number of bytes allocated for the data buffer of
+     * each column. Buffers may have grown beyond `soma.init_buffer_bytes` if
+     * a single cell did not fit, so this can be used to tune the initial
+     * allocation for a workload.
+     *
+     * @return std::map<std::string, size_t> Column name -> bytes
+     */
+    std::map<std::string, size_t> buffer_sizes();
+
     /**
      * @brief Return a view of data in column `name`.
      *
@@ -307,10 +384,48 @@ class ManagedQuery {
     }
 
     /**
-     * @brief Submit the query.
+     * @brief Submit the query. If a prefetched submit is already in flight,
+     * this is a no-op.
      *
+     * @param async Submit on a background thread and return immediately.
+     * Otherwise submit on the calling thread, for callers that already run
+     * on a thread pool.
      */
-    void submit_read();
+    void submit_read(bool async = true);
+
+    /**
+     * @brief Enable or disable read prefetching. When enabled, `results()`
+     * submits the query for the next batch into a second set of buffers on
+     * a background thread before returning the current batch, so that
+     * TileDB I/O overlaps with the caller's processing of the current batch.
+     *
+     * Defaults to the value of the `soma.read_prefetch` config parameter.
+     *
+     * @param prefetch True to enable prefetching
+     */
+    void set_prefetch(bool prefetch) {
+        prefetch_ = prefetch;
+    }
+
+    /**
+     * @brief Set the target number of rows returned by each read. Buffers are
+     * sized to hold this many cells, and a read that returns fewer cells is
+     * continued into the rest of the buffers until the target is reached or
+     * the buffers are full.
+     *
+     * @param batch_rows Number of rows, or std::nullopt to size batches by
+     * the buffer memory alone
+     */
+    void set_batch_rows(std::optional<size_t> batch_rows) {
+        batch_rows_ = batch_rows;
+    }
+
+    /**
+     * @brief Return true if read prefetching is enabled.
+     */
+    bool prefetch() const {
+        return prefetch_;
+    }
 
     /**
      * @brief Return results from the query.
@@ -325,6 +440,21 @@ class ManagedQuery {
      */
     void submit_write(bool sort_coords = true);
 
+    /**
+     * @brief Submit one batch of a sparse global order write without
+     * finalizing the query, so that the next batch is appended to the same
+     * fragment. The cells must be in global order, within and across
+     * batches. Call `finalize_write` after the last batch.
+     *
+     */
+    void submit_global_order_batch();
+
+    /**
+     * @brief Finalize a write started with `submit_global_order_batch`.
+     *
+     */
+    void finalize_write();
+
     /**
      * @brief Get the schema of the array.
      *
@@ -371,6 +501,243 @@ class ManagedQuery {
      */
     void check_column_name(const std::string& name);
 
+    /**
+     * @brief Update the ColumnBuffer sizes to match the query results.
+     *
+     * @return size_t Number of cells read by the last submit
+     */
+    size_t update_buffer_sizes();
+
+    /**
+     * @brief Grow all result buffers geometrically, up to
+     * `soma.max_buffer_bytes`, and attach them to the query again.
+     *
+     * @return true if at least one buffer was expanded
+     */
+    bool expand_buffers();
+
+    /**
+     * @brief Attach a set of result buffers to the query, reusing pooled
+     * buffers that are no longer referenced by a caller or an exported Arrow
+     * array, or allocating new ones.
+     *
+     * @return std::shared_ptr<ArrayBuffers>
+     */
+    std::shared_ptr<ArrayBuffers> alloc_buffers();
+
+    /**
+     * @brief Return a pooled set of result buffers that is no longer in use
+     * and is large enough for the current allocation sizes, if any.
+     *
+     * @return std::shared_ptr<ArrayBuffers> or nullptr
+     */
+    std::shared_ptr<ArrayBuffers> reuse_buffers();
+
+    /**
+     * @brief Size the buffers of the selected columns to hold the same
+     * number of cells: the batch size if one is set, bounded by the read
+     * budget split across the columns. Each column is weighted by its bytes
+     * per cell (type width, offsets, validity and, for var-length columns,
+     * the average value size estimated by TileDB).
+     */
+    void set_alloc_sizes();
+
+    /**
+     * @brief Estimate the average number of data bytes per cell of a
+     * var-length column from TileDB's result size estimate.
+     *
+     * @param name Column name
+     * @param is_nullable True if the column is nullable
+     * @return size_t Average bytes per cell
+     */
+    size_t estimate_var_cell_bytes(const std::string& name, bool is_nullable);
+
+    /**
+     * @brief Return the enumeration values of each enumerated attribute,
+     * loading them on first use. The schema of an open array does not
+     * change, so they are shared by all batches and queries until the array
+     * is closed (and reopened after any schema evolution).
+     *
+     * @return Map: attribute name -> enumeration values
+     */
+    const std::map<std::string, std::shared_ptr<EnumerationBuffers>>&
+    enumerations();
+
+    /**
+     * @brief Points selected on one dimension by `select_points`. They are
+     * added to the subarray when the query is set up, so that the point
+     * selection strategy is chosen once for all the points of the dimension.
+     */
+    struct SelectedPoints {
+        virtual ~SelectedPoints() = default;
+        virtual void apply(ManagedQuery& mq, const std::string& dim) = 0;
+    };
+
+    template <typename T>
+    struct TypedSelectedPoints : SelectedPoints {
+        std::vector<T> points;
+
+        void apply(ManagedQuery& mq, const std::string& dim) override {
+            mq.apply_points(dim, points);
+        }
+    };
+
+    /**
+     * @brief Collect points selected on a dimension, see `SelectedPoints`.
+     *
+     * @tparam T Dimension type
+     * @param dim Dimension name
+     * @param points Pointer to the points
+     * @param num_points Number of points
+     */
+    template <typename T>
+    void add_points(
+        const std::string& dim, const T* points, size_t num_points) {
+        using Point = std::remove_cv_t<T>;
+        subarray_range_set_ = true;
+        auto [empty, inserted] = subarray_range_empty_.emplace(dim, true);
+        if (num_points > 0) {
+            empty->second = false;
+        }
+
+        auto& selected = selected_points_[dim];
+        if (selected == nullptr) {
+            selected = std::make_unique<TypedSelectedPoints<Point>>();
+        }
+        auto typed = dynamic_cast<TypedSelectedPoints<Point>*>(
+            selected.get());
+        if (typed == nullptr) {
+            throw TileDBSOMAError(
+                "[ManagedQuery] Points of different types selected on '" +
+                dim + "'");
+        }
+        typed->points.insert(typed->points.end(), points, points + num_points);
+    }
+
+    /**
+     * @brief Add the points collected by `add_points` to the subarray.
+     */
+    void apply_point_selection();
+
+    /**
+     * @brief Add all the points selected on a dimension to the subarray
+     * using the point selection strategy.
+     *
+     * @tparam T Dimension type
+     * @param dim Dimension name
+     * @param points Points selected on the dimension
+     */
+    template <typename T>
+    void apply_points(const std::string& dim, const std::vector<T>& points) {
+        bool is_sparse = array_->schema().array_type() == TILEDB_SPARSE;
+        auto strategy = point_selection_;
+        if (strategy == PointSelection::points ||
+            (strategy == PointSelection::automatic && !is_sparse)) {
+            for (auto& point : points) {
+                subarray_->add_range(dim, point, point);
+            }
+            return;
+        }
+
+        std::vector<T> sorted(points);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        if (sorted.empty()) {
+            return;
+        }
+
+        // Merge runs of consecutive integers into one range
+        std::vector<std::pair<T, T>> ranges;
+        for (auto& point : sorted) {
+            if constexpr (std::is_integral_v<T>) {
+                if (!ranges.empty() && ranges.back().second + 1 == point) {
+                    ranges.back().second = point;
+                    continue;
+                }
+            }
+            ranges.emplace_back(point, point);
+        }
+
+        if (strategy == PointSelection::automatic) {
+            strategy = PointSelection::ranges;
+            if constexpr (std::is_integral_v<T>) {
+                double span = static_cast<double>(sorted.back()) -
+                              static_cast<double>(sorted.front()) + 1;
+                if (ranges.size() > BOUNDING_RANGE_MIN_RANGES &&
+                    sorted.size() >= BOUNDING_RANGE_MIN_DENSITY * span) {
+                    strategy = PointSelection::bounding_range;
+                }
+            }
+        }
+
+        if (strategy == PointSelection::bounding_range && !is_sparse) {
+            LOG_WARN(
+                "[ManagedQuery] [" + name_ +
+                "] Bounding range point selection is not supported on dense "
+                "arrays, selecting ranges");
+            strategy = PointSelection::ranges;
+        }
+
+        // The points filter would drop the cells of ranges selected on the
+        // dimension by `select_ranges` or `select_point`
+        if (strategy == PointSelection::bounding_range &&
+            subarray_->range_num(dim) > 0) {
+            strategy = PointSelection::ranges;
+        }
+
+        if (strategy == PointSelection::bounding_range && ranges.size() > 1) {
+            LOG_DEBUG(
+                "[ManagedQuery] [" + name_ + "] Selecting " +
+                std::to_string(sorted.size()) + " points on '" + dim +
+                "' with a bounding range");
+            subarray_->add_range(dim, sorted.front(), sorted.back());
+            point_filters_.insert_or_assign(
+                dim,
+                QueryConditionExperimental::create(
+                    *ctx_, dim, sorted, TILEDB_IN));
+            return;
+        }
+
+        LOG_DEBUG(
+            "[ManagedQuery] [" + name_ + "] Selecting " +
+            std::to_string(sorted.size()) + " points on '" + dim + "' as " +
+            std::to_string(ranges.size()) + " ranges");
+        for (auto& [start, stop] : ranges) {
+            subarray_->add_range(dim, start, stop);
+        }
+    }
+
+    /**
+     * @brief Partition the ranges selected on the first dimension, of type T.
+     * See `partition`.
+     *
+     * @tparam T First dimension type
+     * @param num_partitions Number of partitions
+     * @return std::vector<std::vector<std::pair<T, T>>> First dimension
+     * ranges for each non-empty partition
+     */
+    template <typename T>
+    std::vector<std::vector<std::pair<T, T>>> partition_ranges(
+        size_t num_partitions);
+
+    /**
+     * @brief Create one query per partition, reading the same selection as
+     * this query with the ranges on the first dimension replaced by the
+     * ranges of the partition.
+     *
+     * @tparam T First dimension type
+     * @param partition_ranges First dimension ranges for each partition
+     * @return std::vector<std::unique_ptr<ManagedQuery>> Partition queries
+     */
+    template <typename T>
+    std::vector<std::unique_ptr<ManagedQuery>> partition_queries(
+        const std::vector<std::vector<std::pair<T, T>>>& partition_ranges);
+
+    /**
+     * @brief Wait for an in-flight submit, if any, to finish.
+     */
+    void wait_for_submit();
+
     // TileDB array being queried.
     std::shared_ptr<Array> array_;
 
@@ -395,6 +762,20 @@ class ManagedQuery {
     // Map whether the dimension is empty (true) or not
     std::map<std::string, bool> subarray_range_empty_ = {};
 
+    // How points passed to `select_points` are added to the subarray
+    PointSelection point_selection_ = PointSelection::automatic;
+
+    // Map: dimension name -> points selected by `select_points` and not yet
+    // added to the subarray
+    std::map<std::string, std::unique_ptr<SelectedPoints>> selected_points_;
+
+    // Query condition set by the caller
+    std::optional<QueryCondition> condition_;
+
+    // Map: dimension name -> query condition selecting the points within a
+    // bounding range added by `select_points`
+    std::map<std::string, QueryCondition> point_filters_;
+
     // Set of column names to read (dim and attr). If empty, query all columns.
     std::vector<std::string> columns_;
 
@@ -407,9 +788,36 @@ class ManagedQuery {
     // A collection of ColumnBuffers attached to the query
     std::shared_ptr<ArrayBuffers> buffers_;
 
+    // Target number of rows per batch, if set
+    std::optional<size_t> batch_rows_;
+
+    // Map: column name -> (cells, bytes) to allocate for its buffer. Set from
+    // the read budget on the first allocation and updated when buffers are
+    // expanded by a retry, so that later batches use the same sizes.
+    std::map<std::string, std::pair<size_t, size_t>> column_alloc_sizes_;
+
     // True if the query has been submitted
     bool query_submitted_ = false;
 
+    // True if the next batch is submitted before the current one is returned
+    bool prefetch_ = false;
+
+    // True if a prefetched submit is writing into `next_buffers_`
+    bool prefetch_pending_ = false;
+
+    // Buffers for the batch being prefetched
+    std::shared_ptr<ArrayBuffers> next_buffers_;
+
+    // Recently allocated result buffers. A set is reused once the only
+    // reference to it and its column buffers is the one held here.
+    std::vector<std::shared_ptr<ArrayBuffers>> buffer_pool_;
+
+    // Map: attribute name -> enumeration values, for enumerated attributes
+    std::map<std::string, std::shared_ptr<EnumerationBuffers>> enumerations_;
+
+    // True if `enumerations_` has been loaded from the array
+    bool enumerations_loaded_ = false;
+
     // Future for asyncronous query
     std::future<void> query_future_;
 };
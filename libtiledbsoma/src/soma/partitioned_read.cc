@@ -0,0 +1,162 @@
+/**
+ * @file   partitioned_read.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the PartitionedRead class.
+ */
+
+#include "partitioned_read.h"
+#include <thread_pool/thread_pool.h>
+#include "../utils/logger.h"
+
+namespace tiledbsoma {
+
+PartitionedRead::PartitionedRead(
+    std::shared_ptr<SOMAContext> ctx,
+    std::vector<std::unique_ptr<ManagedQuery>> partitions,
+    bool preserve_order)
+    : ctx_(ctx)
+    , partitions_(std::move(partitions))
+    , preserve_order_(preserve_order) {
+    // The partitions are read on the thread pool, do not start another
+    // thread per batch
+    for (auto& mq : partitions_) {
+        mq->set_prefetch(false);
+    }
+}
+
+PartitionedRead::~PartitionedRead() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_ready_.wait(lock, [this] { return num_in_flight_ == 0; });
+}
+
+std::optional<std::shared_ptr<ArrayBuffers>> PartitionedRead::read_next() {
+    if (!started_) {
+        started_ = true;
+        LOG_DEBUG(fmt::format(
+            "[PartitionedRead] Reading {} partitions, preserve_order={}",
+            partitions_.size(),
+            preserve_order_));
+        for (size_t i = 0; i < partitions_.size(); i++) {
+            submit(i);
+        }
+    }
+
+    while (true) {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto next = batches_.end();
+            batch_ready_.wait(lock, [&] {
+                next = std::find_if(
+                    batches_.begin(), batches_.end(), [&](const Batch& b) {
+                        return !preserve_order_ ||
+                               b.partition == current_partition_;
+                    });
+                return next != batches_.end() || num_in_flight_ == 0;
+            });
+            if (next == batches_.end()) {
+                // All partitions are complete
+                return std::nullopt;
+            }
+            batch = std::move(*next);
+            batches_.erase(next);
+        }
+
+        if (batch.error) {
+            std::rethrow_exception(batch.error);
+        }
+
+        if (!batch.results) {
+            LOG_DEBUG(fmt::format(
+                "[PartitionedRead] Partition {} complete", batch.partition));
+            if (preserve_order_) {
+                current_partition_++;
+            }
+            continue;
+        }
+
+        // Read ahead one batch of this partition
+        submit(batch.partition);
+        total_num_cells_ += (*batch.results)->num_rows();
+        return batch.results;
+    }
+}
+
+bool PartitionedRead::is_complete() {
+    if (!started_) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_ready_.wait(lock, [this] { return num_in_flight_ == 0; });
+    return std::none_of(batches_.begin(), batches_.end(), [](const Batch& b) {
+        return b.results || b.error;
+    });
+}
+
+void PartitionedRead::submit(size_t partition) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        num_in_flight_++;
+    }
+
+    auto& thread_pool = ctx_->thread_pool();
+    if (thread_pool == nullptr) {
+        read_partition(partition);
+        return;
+    }
+
+    // The task does not wait on other tasks, so it cannot deadlock the pool
+    thread_pool->execute([this, partition]() {
+        read_partition(partition);
+        return Status::Ok();
+    });
+}
+
+void PartitionedRead::read_partition(size_t partition) {
+    Batch batch{partition, std::nullopt, nullptr};
+    try {
+        auto& mq = partitions_[partition];
+        if (!mq->is_complete(true)) {
+            mq->setup_read();
+            mq->submit_read(false);
+            batch.results = mq->results();
+        }
+    } catch (...) {
+        batch.error = std::current_exception();
+    }
+
+    // Notify while holding the lock, so that the destructor cannot proceed
+    // before this task stops using the object
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.push_back(std::move(batch));
+    num_in_flight_--;
+    batch_ready_.notify_all();
+}
+
+}  // namespace tiledbsoma
@@ -0,0 +1,167 @@
+/**
+ * @file   partitioned_read.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the PartitionedRead class.
+ */
+
+#ifndef PARTITIONED_READ
+#define PARTITIONED_READ
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "array_buffers.h"
+#include "managed_query.h"
+#include "soma_context.h"
+
+namespace tiledbsoma {
+
+/**
+ * @brief Reads a set of disjoint partition queries (see
+ * `ManagedQuery::partition`) concurrently on the SOMAContext thread pool.
+ *
+ * Each partition has at most one batch in flight. When the batch is returned
+ * by `read_next`, the next batch of that partition is submitted. Partition
+ * queries are submitted synchronously inside the thread pool tasks, with
+ * prefetching disabled, so that no extra thread is started per batch.
+ */
+class PartitionedRead {
+   public:
+    /**
+     * @brief Construct a new PartitionedRead object.
+     *
+     * @param ctx SOMAContext providing the thread pool
+     * @param partitions Partition queries
+     * @param preserve_order Return the batches of each partition in
+     * partition order, instead of as they complete
+     */
+    PartitionedRead(
+        std::shared_ptr<SOMAContext> ctx,
+        std::vector<std::unique_ptr<ManagedQuery>> partitions,
+        bool preserve_order);
+
+    PartitionedRead() = delete;
+    PartitionedRead(const PartitionedRead&) = delete;
+    PartitionedRead(PartitionedRead&&) = delete;
+
+    /**
+     * @brief Wait for the batches in flight before destroying the partition
+     * queries.
+     */
+    ~PartitionedRead();
+
+    /**
+     * @brief Return the next batch of results from any partition, or from
+     * the current partition if the order is preserved.
+     *
+     * @return std::optional<std::shared_ptr<ArrayBuffers>> The batch, or
+     * std::nullopt once all partitions are complete
+     */
+    std::optional<std::shared_ptr<ArrayBuffers>> read_next();
+
+    /**
+     * @brief Return true if `read_next` returned all batches of all
+     * partitions. Waits for the batches in flight, which tell whether their
+     * partitions have more results.
+     *
+     * @return bool
+     */
+    bool is_complete();
+
+    /**
+     * @brief Return the total number of cells returned by `read_next`.
+     *
+     * @return size_t
+     */
+    size_t total_num_cells() const {
+        return total_num_cells_;
+    }
+
+   private:
+    // A batch read by a partition, std::nullopt if the partition is complete
+    struct Batch {
+        size_t partition;
+        std::optional<std::shared_ptr<ArrayBuffers>> results;
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Read the next batch of a partition on the thread pool, or on
+     * the calling thread if the context has no thread pool.
+     *
+     * @param partition Partition index
+     */
+    void submit(size_t partition);
+
+    /**
+     * @brief Read the next batch of a partition and queue it for `read_next`.
+     *
+     * @param partition Partition index
+     */
+    void read_partition(size_t partition);
+
+    // SOMA context
+    std::shared_ptr<SOMAContext> ctx_;
+
+    // Partition queries
+    std::vector<std::unique_ptr<ManagedQuery>> partitions_;
+
+    // Return batches in partition order
+    bool preserve_order_;
+
+    // True after the first batch of every partition has been submitted
+    bool started_ = false;
+
+    // Partition returned next when the order is preserved
+    size_t current_partition_ = 0;
+
+    // Number of batches being read
+    size_t num_in_flight_ = 0;
+
+    // Number of cells returned by `read_next`
+    size_t total_num_cells_ = 0;
+
+    // Batches read and not yet returned by `read_next`
+    std::deque<Batch> batches_;
+
+    // Guards `num_in_flight_` and `batches_`
+    std::mutex mutex_;
+
+    // Notified when a batch is queued
+    std::condition_variable batch_ready_;
+};
+
+}  // namespace tiledbsoma
+
+#endif  // PARTITIONED_READ
@@ -32,11 +32,103 @@
 
 #include "soma_array.h"
 #include <tiledb/array_experimental.h>
+#include <cerrno>
+#include <limits>
+#include <type_traits>
 #include "../utils/logger.h"
 #include "../utils/util.h"
 namespace tiledbsoma {
 using namespace tiledb;
 
+namespace {
+
+/**
+ * Running sum, count, min and max of the values of a column, used when
+ * TileDB cannot compute an aggregate itself. Non-nullable spans are reduced
+ * in independent lanes so the compiler can vectorize the inner loop.
+ */
+template <typename T>
+struct ColumnReduction {
+    using sum_type = std::conditional_t<
+        std::is_floating_point_v<T>,
+        double,
+        std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+    static constexpr size_t LANES = 8;
+
+    sum_type sum = 0;
+    uint64_t count = 0;
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+
+    void add(tcb::span<const T> values) {
+        sum_type sums[LANES] = {};
+        T mins[LANES];
+        T maxs[LANES];
+        std::fill(std::begin(mins), std::end(mins), min);
+        std::fill(std::begin(maxs), std::end(maxs), max);
+
+        size_t i = 0;
+        for (; i + LANES <= values.size(); i += LANES) {
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                T value = values[i + lane];
+                sums[lane] += value;
+                mins[lane] = value < mins[lane] ? value : mins[lane];
+                maxs[lane] = value > maxs[lane] ? value : maxs[lane];
+            }
+        }
+        for (; i < values.size(); ++i) {
+            T value = values[i];
+            sums[0] += value;
+            mins[0] = value < mins[0] ? value : mins[0];
+            maxs[0] = value > maxs[0] ? value : maxs[0];
+        }
+
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            sum += sums[lane];
+            min = std::min(min, mins[lane]);
+            max = std::max(max, maxs[lane]);
+        }
+        count += values.size();
+    }
+
+    void add(tcb::span<const T> values, tcb::span<const uint8_t> validity) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (validity[i]) {
+                T value = values[i];
+                sum += value;
+                min = std::min(min, value);
+                max = std::max(max, value);
+                count++;
+            }
+        }
+    }
+
+    std::optional<AggregateValue> result(AggregateOp op) const {
+        switch (op) {
+            case AggregateOp::sum:
+                return sum;
+            case AggregateOp::count:
+                return count;
+            default:
+                break;
+        }
+        if (count == 0) {
+            return std::nullopt;
+        }
+        switch (op) {
+            case AggregateOp::mean:
+                return static_cast<double>(sum) / count;
+            case AggregateOp::min:
+                return static_cast<sum_type>(min);
+            default:
+                return static_cast<sum_type>(max);
+        }
+    }
+};
+
+}  // namespace
+
 //===================================================================
 //= public static
 //===================================================================
@@ -121,6 +213,121 @@ std::unique_ptr<SOMAArray> SOMAArray::open(
         timestamp);
 }
 
+namespace {
+
+/**
+ * @brief State of an Arrow C stream exported by SOMAArray::to_arrow_stream.
+ */
+struct SOMAArrayStream {
+    std::shared_ptr<SOMAArray> array;
+
+    // Schema of the batches, taken from the first batch
+    ArrowSchema schema{};
+
+    // First batch, read to get the schema before get_next is called
+    ArrowArray first_batch{};
+
+    // Error message of the last failed callback
+    std::string last_error;
+
+    ~SOMAArrayStream() {
+        if (schema.release != nullptr) {
+            schema.release(&schema);
+        }
+        if (first_batch.release != nullptr) {
+            first_batch.release(&first_batch);
+        }
+    }
+
+    /**
+     * @brief Read the next batch into `out`, or mark `out` released at the
+     * end of the stream.
+     */
+    void read_next(ArrowArray* out) {
+        auto buffers = array->read_next();
+        if (!buffers.has_value()) {
+            out->release = nullptr;
+            return;
+        }
+        auto [batch, batch_schema] = ArrowAdapter::to_arrow(*buffers);
+        ArrowArrayMove(batch.get(), out);
+        if (schema.release == nullptr) {
+            ArrowSchemaMove(batch_schema.get(), &schema);
+        } else {
+            batch_schema->release(batch_schema.get());
+        }
+    }
+
+    void ensure_schema() {
+        if (schema.release != nullptr) {
+            return;
+        }
+        read_next(&first_batch);
+        if (schema.release == nullptr) {
+            // The read returned no batch: a struct without columns
+            if (ArrowSchemaInitFromType(&schema, NANOARROW_TYPE_STRUCT) !=
+                NANOARROW_OK) {
+                throw TileDBSOMAError(
+                    "[SOMAArray] Bad Arrow stream schema init");
+            }
+        }
+    }
+
+    static SOMAArrayStream* from(struct ArrowArrayStream* stream) {
+        return static_cast<SOMAArrayStream*>(stream->private_data);
+    }
+
+    static int get_schema(struct ArrowArrayStream* stream, ArrowSchema* out) {
+        auto state = from(stream);
+        try {
+            state->ensure_schema();
+            return ArrowSchemaDeepCopy(&state->schema, out);
+        } catch (const std::exception& e) {
+            state->last_error = e.what();
+            return EIO;
+        }
+    }
+
+    static int get_next(struct ArrowArrayStream* stream, ArrowArray* out) {
+        auto state = from(stream);
+        try {
+            if (state->first_batch.release != nullptr) {
+                ArrowArrayMove(&state->first_batch, out);
+            } else {
+                state->read_next(out);
+            }
+            return 0;
+        } catch (const std::exception& e) {
+            state->last_error = e.what();
+            return EIO;
+        }
+    }
+
+    static const char* get_last_error(struct ArrowArrayStream* stream) {
+        auto state = from(stream);
+        return state->last_error.empty() ? nullptr :
+                                           state->last_error.c_str();
+    }
+
+    static void release(struct ArrowArrayStream* stream) {
+        delete from(stream);
+        stream->release = nullptr;
+    }
+};
+
+}  // namespace
+
+void SOMAArray::to_arrow_stream(
+    std::shared_ptr<SOMAArray> array, struct ArrowArrayStream* stream) {
+    auto state = new SOMAArrayStream();
+    state->array = array;
+    stream->get_schema = &SOMAArrayStream::get_schema;
+    stream->get_next = &SOMAArrayStream::get_next;
+    stream->get_last_error = &SOMAArrayStream::get_last_error;
+    stream->release = &SOMAArrayStream::release;
+    stream->private_data = state;
+}
+
 //===================================================================
 //= public non-static
 //===================================================================
@@ -213,6 +420,7 @@ std::shared_ptr<SOMAContext> SOMAArray::ctx() {
 
 void SOMAArray::open(OpenMode mode, std::optional<TimestampRange> timestamp) {
     timestamp_ = timestamp;
+    nnz_.reset();
 
     validate(mode, name_, timestamp);
     reset(column_names(), batch_size_, result_order_);
@@ -220,20 +428,49 @@ void SOMAArray::open(OpenMode mode, std::optional<TimestampRange> timestamp) {
 }
 
 void SOMAArray::close() {
+    if (global_order_write_) {
+        end_global_order_write();
+    }
+
+    // Complete the background writes before closing the array, and throw
+    // their error once it is closed
+    std::exception_ptr write_error;
+    if (write_behind_) {
+        try {
+            if (pending_writes_) {
+                queue_pending_writes();
+            }
+            write_behind_->close();
+        } catch (...) {
+            write_error = std::current_exception();
+        }
+        write_behind_.reset();
+        pending_writes_ = nullptr;
+    }
+
     if (arr_->query_type() == TILEDB_WRITE)
         meta_cache_arr_->close();
 
     // Close the array through the managed query to ensure any pending queries
     // are completed.
+    partitioned_read_.reset();
     mq_->close();
     metadata_.clear();
+    nnz_.reset();
+
+    if (write_error) {
+        std::rethrow_exception(write_error);
+    }
 }
 
 void SOMAArray::reset(
     std::vector<std::string> column_names,
     std::string_view batch_size,
     ResultOrder result_order) {
+    auto batch_rows = _parse_batch_size(batch_size);
+
     // Reset managed query
+    partitioned_read_.reset();
     mq_->reset();
 
     if (!column_names.empty()) {
@@ -260,12 +497,49 @@ void SOMAArray::reset(
     }
 
     batch_size_ = batch_size;
+    mq_->set_batch_rows(batch_rows);
     result_order_ = result_order;
     first_read_next_ = true;
     submitted_ = false;
 }
 
+std::optional<size_t> SOMAArray::_parse_batch_size(
+    std::string_view batch_size) {
+    if (batch_size.empty() || batch_size == "auto") {
+        return std::nullopt;
+    }
+
+    auto batch_size_str = std::string(batch_size);
+    size_t num_parsed = 0;
+    uint64_t batch_rows = 0;
+    try {
+        batch_rows = std::stoull(batch_size_str, &num_parsed);
+    } catch (const std::exception&) {
+        num_parsed = 0;
+    }
+    if (num_parsed != batch_size_str.size() || batch_rows == 0) {
+        throw TileDBSOMAError(fmt::format(
+            "[SOMAArray] batch_size must be 'auto' or a positive number of "
+            "rows: '{}'",
+            batch_size));
+    }
+    return batch_rows;
+}
+
 std::optional<std::shared_ptr<ArrayBuffers>> SOMAArray::read_next() {
+    // Split the query into partitions read concurrently, if requested
+    if (read_partitions_ > 1 && first_read_next_ && !partitioned_read_) {
+        auto partitions = mq_->partition(read_partitions_);
+        if (partitions.size() > 1) {
+            partitioned_read_ = std::make_unique<PartitionedRead>(
+                ctx_, std::move(partitions), preserve_partition_order_);
+        }
+    }
+    if (partitioned_read_) {
+        first_read_next_ = false;
+        return partitioned_read_->read_next();
+    }
+
     // If the query is complete, return `std::nullopt`
     if (mq_->is_complete(true)) {
         return std::nullopt;
@@ -384,12 +658,8 @@ Enumeration SOMAArray::_extend_and_evolve_schema_str(
 
     std::vector<std::string> extend_values;
     auto enums_existing = enmr.as_vector<std::string>();
-    for (auto enum_val : enums_in_write) {
-        if (std::find(enums_existing.begin(), enums_existing.end(), enum_val) ==
-            enums_existing.end()) {
-            extend_values.push_back(enum_val);
-        }
-    }
+    auto dict_remap = SOMAArray::_map_enumeration_values(
+        enums_existing, enums_in_write, extend_values);
 
     if (extend_values.size() != 0) {
         // Check that we extend the enumeration values without
@@ -405,11 +675,7 @@ Enumeration SOMAArray::_extend_and_evolve_schema_str(
         se.array_evolve(uri_);
 
         SOMAArray::_remap_indexes(
-            column_name,
-            extended_enmr,
-            enums_in_write,
-            index_schema,
-            index_array);
+            column_name, dict_remap, index_schema, index_array);
 
         index_schema->format = ArrowAdapter::to_arrow_format(disk_index_type)
                                    .data();
@@ -511,47 +777,51 @@ void SOMAArray::set_array_data(
 
         // Create a ColumnBuffer object instead of passing it in as an argument
         // to `set_column_data` because ColumnBuffer::create requires a TileDB
-        // Array argument which should remain a private member of SOMAArray
-        auto column = ColumnBuffer::create(arr_, arrow_sch_->name);
+        // Array argument which should remain a private member of SOMAArray.
+        // Nothing is allocated since the column borrows the Arrow buffers.
+        auto column = ColumnBuffer::create(arr_, arrow_sch_->name, 0, 0);
 
-        const void* data;
-        uint8_t* validities = nullptr;
+        const uint8_t* validities = nullptr;
         auto table_offset = arrow_arr_->offset;
-        auto data_size = tiledb::impl::type_size(
-            ArrowAdapter::to_tiledb_format(arrow_sch_->format));
-
-        if (arrow_arr_->null_count != 0) {
-            validities = (uint8_t*)arrow_arr_->buffers[0] + table_offset;
+        if (arrow_arr_->null_count != 0 && arrow_arr_->buffers[0] != nullptr) {
+            validities = (const uint8_t*)arrow_arr_->buffers[0];
         }
 
-        if (arrow_arr_->n_buffers == 3) {
-            data = arrow_arr_->buffers[2];
+        if (strcmp(arrow_sch_->format, "b") == 0) {
+            // TileDB stores one byte per boolean
+            column->set_bitmap_data(
+                arrow_arr_->length,
+                (const uint8_t*)arrow_arr_->buffers[1],
+                table_offset,
+                validities);
+        } else if (arrow_arr_->n_buffers == 3) {
+            // Variable length data is not offset: the offsets index into it
+            const void* data = arrow_arr_->buffers[2];
             if ((strcmp(arrow_sch_->format, "u") == 0) ||
                 (strcmp(arrow_sch_->format, "z") == 0)) {
-                uint32_t* offsets = (uint32_t*)arrow_arr_->buffers[1] +
-                                    table_offset;
-                column->set_data(
+                column->set_data_view(
                     arrow_arr_->length,
-                    (char*)data + table_offset * data_size,
-                    offsets,
-                    validities);
+                    data,
+                    (const uint32_t*)arrow_arr_->buffers[1] + table_offset,
+                    validities,
+                    table_offset);
             } else {
-                uint64_t* offsets = (uint64_t*)arrow_arr_->buffers[1] +
-                                    table_offset;
-                column->set_data(
+                column->set_data_view(
                     arrow_arr_->length,
-                    (char*)data + table_offset * data_size,
-                    offsets,
-                    validities);
+                    data,
+                    (const uint64_t*)arrow_arr_->buffers[1] + table_offset,
+                    validities,
+                    table_offset);
             }
-
         } else {
-            data = arrow_arr_->buffers[1];
-            column->set_data(
+            auto data_size = tiledb::impl::type_size(
+                ArrowAdapter::to_tiledb_format(arrow_sch_->format));
+            column->set_data_view(
                 arrow_arr_->length,
-                (char*)data + table_offset * data_size,
-                static_cast<uint64_t*>(nullptr),
-                validities);
+                (const char*)arrow_arr_->buffers[1] + table_offset * data_size,
+                static_cast<const uint64_t*>(nullptr),
+                validities,
+                table_offset);
         }
         // Keep the ColumnBuffer alive by attaching it to the ArrayBuffers class
         // member. Otherwise, the data held by the ColumnBuffer will be garbage
@@ -560,6 +830,10 @@ void SOMAArray::set_array_data(
 
         mq_->set_column_data(column);
     }
+
+    // Keep the Arrow structs, whose buffers the columns point into, until
+    // the write is submitted
+    array_data_.emplace_back(std::move(casted_array), std::move(casted_schema));
 };
 
 ArrowTable SOMAArray::_cast_table(
@@ -622,52 +896,164 @@ ArrowTable SOMAArray::_cast_table(
             }
         }
 
-        if (strcmp(arrow_sch_->format, "b") == 0) {
-            const void* data;
-            if (arrow_arr_->n_buffers == 3) {
-                data = arrow_arr_->buffers[2];
-            } else {
-                data = arrow_arr_->buffers[1];
-            }
+    }
+
+    return ArrowTable(std::move(arrow_array), std::move(arrow_schema));
+}
 
-            auto sz = arrow_arr_->length;
+void SOMAArray::write(bool sort_coords) {
+    if (mq_->query_type() != TILEDB_WRITE) {
+        throw TileDBSOMAError("[SOMAArray] array must be opened in write mode");
+    }
+    if (global_order_write_ && sort_coords) {
+        throw TileDBSOMAError(
+            "[SOMAArray] batches of a global order write must be sorted: call "
+            "write with sort_coords=false or end the global order write");
+    }
+    if (write_behind_) {
+        write_behind_->check();
+
+        // Each batch written with sort_coords=false is only sorted by
+        // itself, so several accumulated batches are written unordered
+        if (!pending_writes_) {
+            pending_writes_ = std::make_shared<ArrayBuffers>();
+            pending_sort_coords_ = sort_coords;
+        } else {
+            pending_sort_coords_ = true;
+        }
 
-            std::vector<uint8_t> casted;
-            for (int64_t i = 0; i * 8 < sz; ++i) {
-                uint8_t byte = ((uint8_t*)data)[i];
-                for (int64_t j = 0; j < 8; ++j) {
-                    casted.push_back((uint8_t)((byte >> j) & 0x01));
+        // Copy the batch, since the caller may release it once write()
+        // returns
+        uint64_t pending_bytes = 0;
+        if (array_buffer_) {
+            for (const auto& name : array_buffer_->names()) {
+                if (!pending_writes_->contains(name)) {
+                    pending_writes_->emplace(
+                        name, ColumnBuffer::create(arr_, name, 0, 0));
                 }
+                auto pending = pending_writes_->at(name);
+                pending->append(*array_buffer_->at(name));
+                pending_bytes += pending->data_bytes();
             }
+        }
+        mq_->reset();
+        array_buffer_ = nullptr;
+        array_data_.clear();
+        remapped_buffers_.clear();
+        nnz_.reset();
+
+        auto pending_rows = pending_writes_->names().empty() ?
+                                0 :
+                                pending_writes_->num_rows();
+        if ((write_behind_rows_ > 0 && pending_rows >= write_behind_rows_) ||
+            (write_behind_bytes_ > 0 && pending_bytes >= write_behind_bytes_)) {
+            queue_pending_writes();
+        }
+        return;
+    }
 
-            arrow_sch_->format = "C";
-            if (arrow_arr_->n_buffers == 3) {
-                arrow_arr_->buffers[2] = malloc(sizeof(uint8_t) * sz);
-                std::memcpy(
-                    (void*)arrow_arr_->buffers[2],
-                    casted.data(),
-                    sizeof(uint8_t) * sz);
-            } else {
-                arrow_arr_->buffers[1] = malloc(sizeof(uint8_t) * sz);
-                std::memcpy(
-                    (void*)arrow_arr_->buffers[1],
-                    casted.data(),
-                    sizeof(uint8_t) * sz);
-            }
+    if (global_order_write_) {
+        // Keep the query open for the next batch. The batch has been copied
+        // into TileDB's tiles, so its buffers can be released.
+        mq_->submit_global_order_batch();
+        global_order_submitted_ = true;
+    } else {
+        mq_->submit_write(sort_coords);
+        mq_->reset();
+    }
+
+    array_buffer_ = nullptr;
+    array_data_.clear();
+    remapped_buffers_.clear();
+    nnz_.reset();
+}
+
+void SOMAArray::set_write_behind(
+    uint64_t flush_rows, uint64_t flush_bytes, size_t max_queued) {
+    if (mq_->query_type() != TILEDB_WRITE) {
+        throw TileDBSOMAError("[SOMAArray] array must be opened in write mode");
+    }
+    if (flush_rows == 0 && flush_bytes == 0) {
+        if (write_behind_) {
+            flush_writes();
+            write_behind_->close();
+            write_behind_.reset();
         }
+        return;
+    }
+    if (mq_->schema()->array_type() != TILEDB_SPARSE) {
+        throw TileDBSOMAError(
+            "[SOMAArray] background writes are only supported for sparse "
+            "arrays");
+    }
+    if (global_order_write_) {
+        throw TileDBSOMAError(
+            "[SOMAArray] background writes cannot be used during a global "
+            "order write");
     }
 
-    return ArrowTable(std::move(arrow_array), std::move(arrow_schema));
+    write_behind_rows_ = flush_rows;
+    write_behind_bytes_ = flush_bytes;
+    if (!write_behind_) {
+        write_behind_ = std::make_unique<WriteBehind>(
+            arr_, ctx_->tiledb_ctx(), max_queued);
+    }
 }
 
-void SOMAArray::write(bool sort_coords) {
+void SOMAArray::flush_writes() {
+    if (!write_behind_) {
+        return;
+    }
+    if (pending_writes_) {
+        queue_pending_writes();
+    }
+    write_behind_->flush();
+}
+
+void SOMAArray::queue_pending_writes() {
+    auto pending = std::move(pending_writes_);
+    pending_writes_ = nullptr;
+    if (!pending->names().empty()) {
+        write_behind_->push(std::move(pending), pending_sort_coords_);
+    }
+}
+
+void SOMAArray::begin_global_order_write() {
     if (mq_->query_type() != TILEDB_WRITE) {
         throw TileDBSOMAError("[SOMAArray] array must be opened in write mode");
     }
-    mq_->submit_write(sort_coords);
+    if (write_behind_) {
+        throw TileDBSOMAError(
+            "[SOMAArray] global order writes cannot be used with background "
+            "writes");
+    }
+    if (mq_->schema()->array_type() != TILEDB_SPARSE) {
+        throw TileDBSOMAError(
+            "[SOMAArray] global order writes are only supported for sparse "
+            "arrays");
+    }
+    if (global_order_write_) {
+        throw TileDBSOMAError(
+            "[SOMAArray] a global order write is already in progress");
+    }
+    mq_->reset();
+    global_order_write_ = true;
+    global_order_submitted_ = false;
+}
+
+void SOMAArray::end_global_order_write() {
+    if (!global_order_write_) {
+        throw TileDBSOMAError("[SOMAArray] no global order write in progress");
+    }
+    global_order_write_ = false;
 
+    // A query that was never submitted has nothing to finalize
+    if (global_order_submitted_) {
+        global_order_submitted_ = false;
+        mq_->finalize_write();
+    }
     mq_->reset();
-    array_buffer_ = nullptr;
+    nnz_.reset();
 }
 
 void SOMAArray::consolidate_and_vacuum(std::vector<std::string> modes) {
@@ -686,6 +1072,15 @@ uint64_t SOMAArray::nnz() {
             "[SOMAArray] nnz is only supported for sparse arrays");
     }
 
+    // The array is opened at a fixed timestamp range, so the count is stable
+    // until the array is reopened, closed or written
+    if (!nnz_) {
+        nnz_ = compute_nnz();
+    }
+    return *nnz_;
+}
+
+uint64_t SOMAArray::compute_nnz() {
     // Load fragment info
     FragmentInfo fragment_info(*ctx_->tiledb_ctx(), uri_);
     fragment_info.load();
@@ -787,22 +1182,277 @@ uint64_t SOMAArray::nnz_slow() {
         "[SOMAArray] nnz() found consolidated or overlapping fragments, "
         "counting cells...");
 
+    // The COUNT aggregate needs a read-mode array at the same timestamp range
+    auto array = read_array();
+
+    // Push the count down to the storage engine so only the result leaves it,
+    // instead of streaming the coordinates back to count them here
+    Query query(*ctx_->tiledb_ctx(), *array);
+    query.set_layout(TILEDB_UNORDERED);
+    QueryChannel channel = QueryExperimental::get_default_channel(query);
+    channel.apply_aggregate("Count", CountOperation());
+
+    uint64_t total_cell_num = 0;
+    query.set_data_buffer("Count", &total_cell_num, 1);
+    query.submit();
+    if (query.query_status() != Query::Status::COMPLETE) {
+        throw TileDBSOMAError(fmt::format(
+            "[SOMAArray] nnz count query on '{}' did not complete", uri_));
+    }
+
+    return total_cell_num;
+}
+
+std::shared_ptr<Array> SOMAArray::read_array() {
+    if (arr_->query_type() == TILEDB_READ) {
+        return arr_;
+    }
+    if (timestamp_) {
+        return std::make_shared<Array>(
+            *ctx_->tiledb_ctx(),
+            uri_,
+            TILEDB_READ,
+            TemporalPolicy(
+                TimestampStartEnd, timestamp_->first, timestamp_->second));
+    }
+    return std::make_shared<Array>(*ctx_->tiledb_ctx(), uri_, TILEDB_READ);
+}
+
+std::optional<AggregateValue> SOMAArray::aggregate(
+    const std::string& column,
+    AggregateOp op,
+    std::optional<QueryCondition> condition) {
+    auto schema = tiledb_schema();
+    tiledb_datatype_t type;
+    bool nullable = false;
+    if (schema->has_attribute(column)) {
+        auto attr = schema->attribute(column);
+        if (attr.cell_val_num() != 1) {
+            throw TileDBSOMAError(fmt::format(
+                "[SOMAArray] aggregate: column '{}' is not fixed-size",
+                column));
+        }
+        type = attr.type();
+        nullable = attr.nullable();
+    } else if (schema->domain().has_dimension(column)) {
+        type = schema->domain().dimension(column).type();
+    } else {
+        throw TileDBSOMAError(fmt::format(
+            "[SOMAArray] aggregate: no column named '{}' in array '{}'",
+            column,
+            uri_));
+    }
+
+    auto reduce = [&](auto tag) {
+        using T = decltype(tag);
+        try {
+            return aggregate_pushdown<T>(column, nullable, op, condition);
+        } catch (const TileDBError& e) {
+            LOG_DEBUG(fmt::format(
+                "[SOMAArray] aggregate on '{}' not pushed down, reducing "
+                "natively: {}",
+                column,
+                e.what()));
+            return aggregate_native<T>(column, op, condition);
+        }
+    };
+
+    switch (type) {
+        case TILEDB_INT8:
+            return reduce(int8_t{});
+        case TILEDB_UINT8:
+        case TILEDB_BOOL:
+            return reduce(uint8_t{});
+        case TILEDB_INT16:
+            return reduce(int16_t{});
+        case TILEDB_UINT16:
+            return reduce(uint16_t{});
+        case TILEDB_INT32:
+            return reduce(int32_t{});
+        case TILEDB_UINT32:
+            return reduce(uint32_t{});
+        case TILEDB_INT64:
+        case TILEDB_DATETIME_YEAR:
+        case TILEDB_DATETIME_MONTH:
+        case TILEDB_DATETIME_WEEK:
+        case TILEDB_DATETIME_DAY:
+        case TILEDB_DATETIME_HR:
+        case TILEDB_DATETIME_MIN:
+        case TILEDB_DATETIME_SEC:
+        case TILEDB_DATETIME_MS:
+        case TILEDB_DATETIME_US:
+        case TILEDB_DATETIME_NS:
+        case TILEDB_DATETIME_PS:
+        case TILEDB_DATETIME_FS:
+        case TILEDB_DATETIME_AS:
+        case TILEDB_TIME_HR:
+        case TILEDB_TIME_MIN:
+        case TILEDB_TIME_SEC:
+        case TILEDB_TIME_MS:
+        case TILEDB_TIME_US:
+        case TILEDB_TIME_NS:
+        case TILEDB_TIME_PS:
+        case TILEDB_TIME_FS:
+        case TILEDB_TIME_AS:
+            return reduce(int64_t{});
+        case TILEDB_UINT64:
+            return reduce(uint64_t{});
+        case TILEDB_FLOAT32:
+            return reduce(float{});
+        case TILEDB_FLOAT64:
+            return reduce(double{});
+        default:
+            throw TileDBSOMAError(fmt::format(
+                "[SOMAArray] aggregate: column '{}' is not numeric", column));
+    }
+}
+
+template <typename T>
+std::optional<AggregateValue> SOMAArray::aggregate_pushdown(
+    const std::string& column,
+    bool nullable,
+    AggregateOp op,
+    const std::optional<QueryCondition>& condition) {
+    auto array = read_array();
+    Query query(*ctx_->tiledb_ctx(), *array);
+    if (array->schema().array_type() == TILEDB_SPARSE) {
+        query.set_layout(TILEDB_UNORDERED);
+    } else {
+        // Reduce the cells aggregate_native reads: ManagedQuery selects the
+        // non-empty domain of dimension 0 of a dense array
+        query.set_layout(TILEDB_ROW_MAJOR);
+        auto [start, end] = array->non_empty_domain<int64_t>(0);
+        Subarray subarray(*ctx_->tiledb_ctx(), *array);
+        subarray.add_range(0, start, end);
+        query.set_subarray(subarray);
+    }
+    if (condition) {
+        query.set_condition(*condition);
+    }
+
+    // Count the cells and null values alongside the requested reduction, to
+    // tell an empty selection apart from a reduction that returned 0
+    QueryChannel channel = QueryExperimental::get_default_channel(query);
+    uint64_t cell_count = 0;
+    uint64_t null_count = 0;
+    channel.apply_aggregate("Count", CountOperation());
+    query.set_data_buffer("Count", &cell_count, 1);
+    if (nullable) {
+        channel.apply_aggregate(
+            "NullCount",
+            QueryExperimental::create_unary_aggregate<NullCountOperator>(
+                query, column));
+        query.set_data_buffer("NullCount", &null_count, 1);
+    }
+
+    typename ColumnReduction<T>::sum_type sum = 0;
+    double mean = 0;
+    T extreme = 0;
+    uint8_t validity = 0;
+    switch (op) {
+        case AggregateOp::sum:
+            channel.apply_aggregate(
+                "Sum",
+                QueryExperimental::create_unary_aggregate<SumOperator>(
+                    query, column));
+            query.set_data_buffer("Sum", &sum, 1);
+            if (nullable) {
+                query.set_validity_buffer("Sum", &validity, 1);
+            }
+            break;
+        case AggregateOp::mean:
+            channel.apply_aggregate(
+                "Mean",
+                QueryExperimental::create_unary_aggregate<MeanOperator>(
+                    query, column));
+            query.set_data_buffer("Mean", &mean, 1);
+            if (nullable) {
+                query.set_validity_buffer("Mean", &validity, 1);
+            }
+            break;
+        case AggregateOp::min:
+            channel.apply_aggregate(
+                "Min",
+                QueryExperimental::create_unary_aggregate<MinOperator>(
+                    query, column));
+            query.set_data_buffer("Min", &extreme, 1);
+            if (nullable) {
+                query.set_validity_buffer("Min", &validity, 1);
+            }
+            break;
+        case AggregateOp::max:
+            channel.apply_aggregate(
+                "Max",
+                QueryExperimental::create_unary_aggregate<MaxOperator>(
+                    query, column));
+            query.set_data_buffer("Max", &extreme, 1);
+            if (nullable) {
+                query.set_validity_buffer("Max", &validity, 1);
+            }
+            break;
+        case AggregateOp::count:
+            break;
+    }
+
+    query.submit();
+    if (query.query_status() != Query::Status::COMPLETE) {
+        throw TileDBSOMAError(fmt::format(
+            "[SOMAArray] aggregate query on '{}' did not complete", uri_));
+    }
+
+    using sum_type = typename ColumnReduction<T>::sum_type;
+    uint64_t value_count = cell_count - null_count;
+    if (op == AggregateOp::count) {
+        return value_count;
+    }
+    if (value_count == 0) {
+        if (op == AggregateOp::sum) {
+            return sum_type{0};
+        }
+        return std::nullopt;
+    }
+    switch (op) {
+        case AggregateOp::sum:
+            return sum;
+        case AggregateOp::mean:
+            return mean;
+        default:
+            return static_cast<sum_type>(extreme);
+    }
+}
+
+template <typename T>
+std::optional<AggregateValue> SOMAArray::aggregate_native(
+    const std::string& column,
+    AggregateOp op,
+    const std::optional<QueryCondition>& condition) {
     auto sr = SOMAArray::open(
         OpenMode::read,
         uri_,
         ctx_,
-        "count_cells",
-        {mq_->schema()->domain().dimension(0).name()},
+        "aggregate",
+        {column},
         batch_size_,
-        result_order_,
+        ResultOrder::automatic,
         timestamp_);
+    if (condition) {
+        QueryCondition qc = *condition;
+        sr->set_condition(qc);
+    }
 
-    uint64_t total_cell_num = 0;
+    ColumnReduction<T> reduction;
     while (auto batch = sr->read_next()) {
-        total_cell_num += (*batch)->num_rows();
+        auto buffer = (*batch)->at(column);
+        auto values = buffer->data<T>();
+        if (buffer->is_nullable()) {
+            reduction.add(values, buffer->validity());
+        } else {
+            reduction.add(values);
+        }
     }
+    sr->close();
 
-    return total_cell_num;
+    return reduction.result(op);
 }
 
 std::vector<int64_t> SOMAArray::shape() {
@@ -36,6 +36,8 @@
 #include <stdexcept>  // for windows: error C2039: 'runtime_error': is not a member of 'std'
 
 #include <future>
+#include <unordered_map>
+#include <variant>
 
 #include <tiledb/tiledb>
 #include <tiledb/tiledb_experimental>
@@ -43,11 +45,19 @@
 #include "enums.h"
 #include "logger_public.h"
 #include "managed_query.h"
+#include "partitioned_read.h"
 #include "soma_object.h"
+#include "write_behind.h"
 
 namespace tiledbsoma {
 using namespace tiledb;
 
+/**
+ * Result of SOMAArray::aggregate: an integer for counts and for the sum, min
+ * and max of integer columns, so large values keep their precision.
+ */
+using AggregateValue = std::variant<int64_t, uint64_t, double>;
+
 class SOMAArray : public SOMAObject {
    public:
     //===================================================================
@@ -119,6 +129,19 @@ class SOMAArray : public SOMAObject {
         ResultOrder result_order = ResultOrder::automatic,
         std::optional<TimestampRange> timestamp = std::nullopt);
 
+    /**
+     * @brief Export the batches read by a SOMAArray as an Arrow C stream.
+     * Each call to the stream's `get_next` reads the next batch with
+     * `read_next` and returns it as a struct array. The schema is taken from
+     * the first batch and cached. The stream keeps `array` alive until it
+     * is released.
+     *
+     * @param array SOMAArray opened for read, with the query set up
+     * @param stream Stream to initialize
+     */
+    static void to_arrow_stream(
+        std::shared_ptr<SOMAArray> array, struct ArrowArrayStream* stream);
+
     //===================================================================
     //= public non-static
     //===================================================================
@@ -251,7 +274,7 @@ class SOMAArray : public SOMAObject {
      * new query, while holding the array open.
      *
      * @param column_names
-     * @param batch_size
+     * @param batch_size "auto" or the target number of rows per batch
      * @param result_order
      */
     void reset(
@@ -319,8 +342,7 @@ class SOMAArray : public SOMAObject {
                     << points.size() << "points";
             LOG_DEBUG(log_dbg.str());
 
-            mq_->select_points(
-                dim, tcb::span<T>{&points[start], partition_size});
+            mq_->select_points(dim, points.subspan(start, partition_size));
         } else {
             mq_->select_points(dim, points);
         }
@@ -358,6 +380,16 @@ class SOMAArray : public SOMAObject {
         mq_->select_ranges(dim, ranges);
     }
 
+    /**
+     * @brief Set how points passed to `set_dim_points` are added to the
+     * query. See `ManagedQuery::set_point_selection`.
+     *
+     * @param point_selection Point selection strategy
+     */
+    void set_point_selection(PointSelection point_selection) {
+        mq_->set_point_selection(point_selection);
+    }
+
     /**
      * @brief Set a query condition.
      *
@@ -412,10 +444,32 @@ class SOMAArray : public SOMAObject {
      *       ...process batch ...
      *   }
      *
+     * If the `soma.read_prefetch` config parameter is "true", the next batch
+     * is read in the background while the caller processes this one.
+     *
      * @return std::optional<std::shared_ptr<ArrayBuffers>>
      */
     std::optional<std::shared_ptr<ArrayBuffers>> read_next();
 
+    /**
+     * @brief Read with `num_partitions` concurrent queries, each selecting a
+     * disjoint span of the first dimension (see `ManagedQuery::partition`).
+     * The queries are read on the SOMAContext thread pool, and `read_next`
+     * returns their batches as they complete, or in partition order if
+     * `preserve_order` is true.
+     *
+     * Arrays that cannot be partitioned are read with a single query. The
+     * setting is kept across calls to `reset`.
+     *
+     * @param num_partitions Number of partitions, 1 to disable
+     * @param preserve_order Return batches in partition order
+     */
+    void set_read_partitions(
+        size_t num_partitions, bool preserve_order = false) {
+        read_partitions_ = num_partitions;
+        preserve_partition_order_ = preserve_order;
+    }
+
     Enumeration extend_enumeration(
         ArrowSchema* value_schema,
         ArrowArray* value_array,
@@ -461,6 +515,10 @@ class SOMAArray : public SOMAObject {
      * @brief Set the write buffers for an Arrow Table or Batch as represented
      * by an ArrowSchema and ArrowArray.
      *
+     * The Arrow buffers are not copied: they must stay valid until `write()`
+     * returns. Only buffers whose layout differs from TileDB's are converted:
+     * validity bitmaps, 32-bit offsets and boolean bitmaps.
+     *
      * @param arrow_schema
      * @param arrow_array
      */
@@ -479,9 +537,66 @@ class SOMAArray : public SOMAObject {
      *      std::make_unique<ArrowArray>(arrow_array));
      *   array.write();
      *   array.close();
+     *
+     * Between `begin_global_order_write` and `end_global_order_write`, the
+     * batch is appended to the open global order write instead. Its cells
+     * must already be sorted, so `sort_coords` must be false.
      */
     void write(bool sort_coords = true);
 
+    /**
+     * @brief Start writing pre-sorted batches into a single fragment.
+     *
+     * Each `write()` until `end_global_order_write()` submits its batch to
+     * one sparse global order query, which is finalized once at the end.
+     * The cells must be in global order within and across batches. `close()`
+     * ends an open global order write.
+     *
+     *   array.begin_global_order_write();
+     *   for (auto& batch : sorted_batches) {
+     *       array.set_array_data(batch.schema, batch.array);
+     *       array.write(false);
+     *   }
+     *   array.end_global_order_write();
+     */
+    void begin_global_order_write();
+
+    /**
+     * @brief Finalize the fragment written since `begin_global_order_write`.
+     * Nothing is written if no batch was.
+     */
+    void end_global_order_write();
+
+    /**
+     * @brief Write batches in the background.
+     *
+     * The batches passed to `write()` are copied and accumulated until they
+     * reach `flush_rows` rows or `flush_bytes` bytes, then written as one
+     * fragment on a background thread while the caller prepares the next
+     * batches. When `max_queued` accumulated batches are waiting to be
+     * written, `write()` blocks until one of them is. The error of a
+     * background write is thrown by the next `write()`, `flush_writes()` or
+     * `close()`. A batch written with `sort_coords=false` is only written in
+     * global order if it is not accumulated with other batches.
+     *
+     * Passing 0 for both thresholds flushes and returns to synchronous
+     * writes. Only sparse arrays are supported.
+     *
+     * @param flush_rows Number of rows accumulated before a write, 0 for no
+     * row threshold
+     * @param flush_bytes Number of bytes accumulated before a write, 0 for no
+     * byte threshold
+     * @param max_queued Maximum number of writes waiting in the background
+     */
+    void set_write_behind(
+        uint64_t flush_rows, uint64_t flush_bytes, size_t max_queued = 2);
+
+    /**
+     * @brief Write the batches accumulated by `set_write_behind` and wait
+     * for the background writes to complete.
+     */
+    void flush_writes();
+
     /**
      * @brief Consolidates and vacuums fragment metadata and commit files.
      *
@@ -505,6 +620,9 @@ class SOMAArray : public SOMAObject {
      * @return true if the query is complete, as described above
      */
     bool is_complete(bool query_status_only = false) {
+        if (partitioned_read_) {
+            return partitioned_read_->is_complete();
+        }
         return mq_->is_complete(query_status_only);
     }
 
@@ -516,6 +634,9 @@ class SOMAArray : public SOMAObject {
      * query
      */
     bool results_complete() {
+        if (partitioned_read_) {
+            return partitioned_read_->is_complete();
+        }
         return mq_->results_complete();
     }
 
@@ -526,9 +647,22 @@ class SOMAArray : public SOMAObject {
      * @return size_t Total number of cells read
      */
     size_t total_num_cells() {
+        if (partitioned_read_) {
+            return partitioned_read_->total_num_cells();
+        }
         return mq_->total_num_cells();
     }
 
+    /**
+     * @brief Return the number of bytes allocated for the read buffer of
+     * each column, including any growth needed to fit large cells.
+     *
+     * @return std::map<std::string, size_t> Column name -> bytes
+     */
+    std::map<std::string, size_t> buffer_sizes() {
+        return mq_->buffer_sizes();
+    }
+
     /**
      * @brief Return whether next read is the initial read, or a subsequent
      * read of a previous incomplete query.
@@ -542,10 +676,35 @@ class SOMAArray : public SOMAObject {
     /**
      * @brief Get the total number of unique cells in the array.
      *
+     * The result is cached until the array is reopened, closed or written.
+     *
      * @return uint64_t Total number of unique cells
      */
     uint64_t nnz();
 
+    /**
+     * @brief Reduce a numeric attribute or dimension to a single value.
+     *
+     * The reduction is pushed down to the TileDB aggregate channel. If
+     * TileDB cannot compute it for this array or column, the column is
+     * read in batches and reduced here. Null values are skipped. `count`
+     * returns the number of non-null values and `sum` returns 0 when there
+     * are none; `mean`, `min` and `max` return std::nullopt instead.
+     * `count` is a uint64_t and `mean` a double. `sum`, `min` and `max` are
+     * an int64_t for signed integer columns, a uint64_t for unsigned ones
+     * and a double for floating-point ones. Dense arrays are reduced over
+     * the non-empty domain of their first dimension, as read by default.
+     *
+     * @param column Name of the attribute or dimension
+     * @param op The reduction to compute
+     * @param condition Optional query condition selecting the cells
+     * @return std::optional<AggregateValue> The reduced value
+     */
+    std::optional<AggregateValue> aggregate(
+        const std::string& column,
+        AggregateOp op,
+        std::optional<QueryCondition> condition = std::nullopt);
+
     /**
      * @brief Get the TileDB ArraySchema. This should eventually
      * be removed in lieu of arrow_schema below.
@@ -778,13 +937,8 @@ class SOMAArray : public SOMAObject {
             (ValueType*)data, (ValueType*)data + num_elems);
         auto enums_existing = enmr.as_vector<ValueType>();
         std::vector<ValueType> extend_values;
-        for (auto enum_val : enums_in_write) {
-            if (std::find(
-                    enums_existing.begin(), enums_existing.end(), enum_val) ==
-                enums_existing.end()) {
-                extend_values.push_back(enum_val);
-            }
-        }
+        auto dict_remap = SOMAArray::_map_enumeration_values(
+            enums_existing, enums_in_write, extend_values);
 
         if (extend_values.size() != 0) {
             auto free_capacity = max_capacity - enums_existing.size();
@@ -797,11 +951,7 @@ class SOMAArray : public SOMAObject {
             se.extend_enumeration(extended_enmr);
             se.array_evolve(uri_);
             SOMAArray::_remap_indexes(
-                column_name,
-                extended_enmr,
-                enums_in_write,
-                index_schema,
-                index_array);
+                column_name, dict_remap, index_schema, index_array);
 
             index_schema->format = ArrowAdapter::to_arrow_format(
                                        disk_index_type)
@@ -819,47 +969,87 @@ class SOMAArray : public SOMAObject {
         ArrowSchema* index_schema,
         ArrowArray* index_array);
 
+    /**
+     * Map each value of the dictionary being written to its index in the
+     * enumeration extended by the values it does not contain yet. The
+     * existing values are hashed once, so this is linear in the size of both
+     * enumerations.
+     *
+     * @param enums_existing Values of the enumeration on disk
+     * @param enums_in_write Dictionary values of the data being written
+     * @param extend_values Returns the values to extend the enumeration with
+     * @return std::vector<uint64_t> Index of each dictionary value
+     */
     template <typename ValueType>
+    static std::vector<uint64_t> _map_enumeration_values(
+        const std::vector<ValueType>& enums_existing,
+        const std::vector<ValueType>& enums_in_write,
+        std::vector<ValueType>& extend_values) {
+        // Strings are keyed by views into the two vectors, which outlive
+        // the map
+        using Key = std::conditional_t<
+            std::is_same_v<ValueType, std::string>,
+            std::string_view,
+            ValueType>;
+
+        std::unordered_map<Key, uint64_t> positions;
+        positions.reserve(enums_existing.size() + enums_in_write.size());
+        for (uint64_t i = 0; i < enums_existing.size(); ++i) {
+            positions.emplace(Key(enums_existing[i]), i);
+        }
+
+        std::vector<uint64_t> dict_remap;
+        dict_remap.reserve(enums_in_write.size());
+        for (const auto& enum_val : enums_in_write) {
+            auto [it, inserted] = positions.emplace(
+                Key(enum_val), enums_existing.size() + extend_values.size());
+            if (inserted) {
+                extend_values.push_back(enum_val);
+            }
+            dict_remap.push_back(it->second);
+        }
+        return dict_remap;
+    }
+
     void _remap_indexes(
         std::string column_name,
-        Enumeration extended_enmr,
-        std::vector<ValueType> enums_in_write,
+        const std::vector<uint64_t>& dict_remap,
         ArrowSchema* index_schema,
         ArrowArray* index_array) {
         auto user_index_type = ArrowAdapter::to_tiledb_format(
             index_schema->format);
         switch (user_index_type) {
             case TILEDB_INT8:
-                SOMAArray::_remap_indexes_aux<ValueType, int8_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<int8_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_UINT8:
-                SOMAArray::_remap_indexes_aux<ValueType, uint8_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<uint8_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_INT16:
-                SOMAArray::_remap_indexes_aux<ValueType, int16_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<int16_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_UINT16:
-                SOMAArray::_remap_indexes_aux<ValueType, uint16_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<uint16_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_INT32:
-                SOMAArray::_remap_indexes_aux<ValueType, int32_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<int32_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_UINT32:
-                SOMAArray::_remap_indexes_aux<ValueType, uint32_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<uint32_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_INT64:
-                SOMAArray::_remap_indexes_aux<ValueType, int64_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<int64_t>(
+                    column_name, dict_remap, index_array);
                 break;
             case TILEDB_UINT64:
-                SOMAArray::_remap_indexes_aux<ValueType, uint64_t>(
-                    column_name, extended_enmr, enums_in_write, index_array);
+                SOMAArray::_remap_indexes_aux<uint64_t>(
+                    column_name, dict_remap, index_array);
                 break;
             default:
                 throw TileDBSOMAError(
@@ -868,56 +1058,37 @@ class SOMAArray : public SOMAObject {
         }
     }
 
-    template <typename ValueType, typename IndexType>
+    template <typename IndexType>
     void _remap_indexes_aux(
         std::string column_name,
-        Enumeration extended_enmr,
-        std::vector<ValueType> enums_in_write,
+        const std::vector<uint64_t>& dict_remap,
         ArrowArray* index_array) {
-        IndexType* idxbuf;
-        if (index_array->n_buffers == 3) {
-            idxbuf = (IndexType*)index_array->buffers[2];
-        } else {
-            idxbuf = (IndexType*)index_array->buffers[1];
-        }
-
-        auto enmr_vec = extended_enmr.as_vector<ValueType>();
-        auto beg = enmr_vec.begin();
-        auto end = enmr_vec.end();
-        std::vector<IndexType> original_indexes(
-            idxbuf, idxbuf + index_array->length);
-        std::vector<IndexType> shifted_indexes;
-        for (auto i : original_indexes) {
-            auto it = std::find(beg, end, enums_in_write[i]);
-            shifted_indexes.push_back(it - beg);
-        }
-
         auto attr = tiledb_schema()->attribute(column_name);
         switch (attr.type()) {
             case TILEDB_INT8:
                 return SOMAArray::_cast_shifted_indexes<IndexType, int8_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_UINT8:
                 return SOMAArray::_cast_shifted_indexes<IndexType, uint8_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_INT16:
                 return SOMAArray::_cast_shifted_indexes<IndexType, int16_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_UINT16:
                 return SOMAArray::_cast_shifted_indexes<IndexType, uint16_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_INT32:
                 return SOMAArray::_cast_shifted_indexes<IndexType, int32_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_UINT32:
                 return SOMAArray::_cast_shifted_indexes<IndexType, uint32_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_INT64:
                 return SOMAArray::_cast_shifted_indexes<IndexType, int64_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             case TILEDB_UINT64:
                 return SOMAArray::_cast_shifted_indexes<IndexType, uint64_t>(
-                    shifted_indexes, index_array);
+                    dict_remap, index_array);
             default:
                 throw TileDBSOMAError(
                     "Saw invalid enumeration index type when trying to extend"
@@ -927,32 +1098,73 @@ class SOMAArray : public SOMAObject {
 
     template <typename UserIndexType, typename DiskIndexType>
     void _cast_shifted_indexes(
-        std::vector<UserIndexType> shifted_indexes, ArrowArray* index_array) {
-        std::vector<DiskIndexType> casted_indexes;
-        for (auto i : shifted_indexes) {
-            casted_indexes.push_back(i);
+        const std::vector<uint64_t>& dict_remap, ArrowArray* index_array) {
+        int data_buffer = index_array->n_buffers == 3 ? 2 : 1;
+        auto offset = index_array->offset;
+        auto idxbuf = (const UserIndexType*)index_array->buffers[data_buffer] +
+                      offset;
+
+        // The indexes are left in place when neither their value nor their
+        // type changes
+        if constexpr (std::is_same_v<UserIndexType, DiskIndexType>) {
+            bool identity = true;
+            for (uint64_t k = 0; k < dict_remap.size() && identity; ++k) {
+                identity = dict_remap[k] == k;
+            }
+            if (identity) {
+                return;
+            }
         }
 
-        if (index_array->n_buffers == 3) {
-            index_array->buffers[2] = malloc(
-                sizeof(DiskIndexType) * casted_indexes.size());
-            std::memcpy(
-                (void*)index_array->buffers[2],
-                casted_indexes.data(),
-                sizeof(DiskIndexType) * casted_indexes.size());
-        } else {
-            index_array->buffers[1] = malloc(
-                sizeof(DiskIndexType) * casted_indexes.size());
-            std::memcpy(
-                (void*)index_array->buffers[1],
-                casted_indexes.data(),
-                sizeof(DiskIndexType) * casted_indexes.size());
+        // Remap and cast each index in a single pass into a new buffer, kept
+        // until the write is submitted
+        auto bits = static_cast<const uint8_t*>(index_array->buffers[0]);
+        auto is_valid = [bits, offset](int64_t i) {
+            return bits == nullptr ||
+                   ((bits[(offset + i) / 8] >> ((offset + i) % 8)) & 1);
+        };
+        auto& casted = remapped_buffers_.emplace_back(
+            sizeof(DiskIndexType) * index_array->length);
+        auto casted_indexes = reinterpret_cast<DiskIndexType*>(casted.data());
+        for (int64_t i = 0; i < index_array->length; ++i) {
+            // Null slots may hold any index, they are left at zero
+            if (!is_valid(i)) {
+                continue;
+            }
+            // Negative indexes wrap around to large ones
+            auto index = static_cast<uint64_t>(idxbuf[i]);
+            if (index >= dict_remap.size()) {
+                throw TileDBSOMAError(fmt::format(
+                    "Enumeration index at position {} is out of range for "
+                    "{} enumeration values",
+                    i,
+                    dict_remap.size()));
+            }
+            casted_indexes[i] = static_cast<DiskIndexType>(dict_remap[index]);
+        }
+        index_array->buffers[data_buffer] = casted_indexes;
+
+        // The new buffer starts at the first index, so move the validity
+        // bitmap to start there too and drop the offset
+        if (offset != 0 && bits != nullptr) {
+            auto& validity = remapped_buffers_.emplace_back(
+                (index_array->length + 7) / 8);
+            for (int64_t i = 0; i < index_array->length; ++i) {
+                if (is_valid(i)) {
+                    validity[i / 8] |= 1 << (i % 8);
+                }
+            }
+            index_array->buffers[0] = validity.data();
         }
+        index_array->offset = 0;
     }
 
     // Helper function for set_column_data
     std::shared_ptr<ColumnBuffer> _setup_column_data(std::string_view name);
 
+    // Parse a batch size, "auto" or a number of rows, into a row target
+    static std::optional<size_t> _parse_batch_size(std::string_view batch_size);
+
     // Fills the metadata cache upon opening the array.
     void fill_metadata_cache();
 
@@ -985,6 +1197,15 @@ class SOMAArray : public SOMAObject {
     // Managed query for the array
     std::unique_ptr<ManagedQuery> mq_;
 
+    // Number of partition queries used by read_next, 1 to read with mq_
+    size_t read_partitions_ = 1;
+
+    // Return the batches of partition queries in partition order
+    bool preserve_partition_order_ = false;
+
+    // Partition queries of mq_, created by the first read_next
+    std::unique_ptr<PartitionedRead> partitioned_read_;
+
     // Array associated with mq_
     std::shared_ptr<Array> arr_;
 
@@ -999,11 +1220,69 @@ class SOMAArray : public SOMAObject {
     // True if the query was submitted
     bool submitted_ = false;
 
-    // Unoptimized method for computing nnz() (issue `count_cells` query)
+    // Cached result of nnz() for the open array and its timestamp range
+    std::optional<uint64_t> nnz_;
+
+    // Compute nnz() from fragment info, falling back to nnz_slow()
+    uint64_t compute_nnz();
+
+    // Count cells with a COUNT aggregate query when fragment info cannot be
+    // used (consolidated or overlapping fragments, partial timestamp ranges)
     uint64_t nnz_slow();
 
+    // Open array in read mode at the same timestamp range, arr_ if it is
+    // already opened for reading
+    std::shared_ptr<Array> read_array();
+
+    // Compute aggregate() with the TileDB aggregate channel
+    template <typename T>
+    std::optional<AggregateValue> aggregate_pushdown(
+        const std::string& column,
+        bool nullable,
+        AggregateOp op,
+        const std::optional<QueryCondition>& condition);
+
+    // Compute aggregate() by reading the column and reducing the batches
+    template <typename T>
+    std::optional<AggregateValue> aggregate_native(
+        const std::string& column,
+        AggregateOp op,
+        const std::optional<QueryCondition>& condition);
+
+    // True between begin_global_order_write and end_global_order_write
+    bool global_order_write_ = false;
+
+    // True once a batch was submitted to the global order write
+    bool global_order_submitted_ = false;
+
+    // Background writer, set by set_write_behind
+    std::unique_ptr<WriteBehind> write_behind_;
+
+    // Thresholds, in rows and bytes, of the batches written in the
+    // background. 0 disables a threshold.
+    uint64_t write_behind_rows_ = 0;
+    uint64_t write_behind_bytes_ = 0;
+
+    // Batches accumulated for the next background write
+    std::shared_ptr<ArrayBuffers> pending_writes_;
+
+    // Write pending_writes_ unordered: false only if it holds a single batch
+    // written with sort_coords=false
+    bool pending_sort_coords_ = true;
+
+    // Queue pending_writes_ to the background writer
+    void queue_pending_writes();
+
     // ArrayBuffers to hold ColumnBuffers alive when submitting to write query
     std::shared_ptr<ArrayBuffers> array_buffer_ = nullptr;
+
+    // Arrow tables passed to set_array_data, whose buffers are borrowed by
+    // the ColumnBuffers in array_buffer_ until the write query is submitted
+    std::vector<ArrowTable> array_data_;
+
+    // Enumeration indexes remapped by set_array_data, and their validity,
+    // borrowed by array_data_ until the write query is submitted
+    std::vector<std::vector<uint8_t>> remapped_buffers_;
 };
 
 }  // namespace tiledbsoma
@@ -31,6 +31,8 @@
  */
 
 #include "soma_collection.h"
+#include <thread_pool/thread_pool.h>
+#include <unordered_set>
 #include "soma_experiment.h"
 #include "soma_measurement.h"
 
@@ -69,21 +71,115 @@ std::unique_ptr<SOMACollection> SOMACollection::open(
 //===================================================================
 
 void SOMACollection::close() {
-    for (auto mem : children_) {
-        if (mem.second->is_open()) {
-            mem.second->close();
+    {
+        std::lock_guard<std::mutex> lock(members_mutex_);
+        for (auto mem : children_) {
+            if (mem.second->is_open()) {
+                mem.second->close();
+            }
         }
+
+        // Cached members may still be held by callers, so they are not closed
+        cached_members_.clear();
     }
     SOMAGroup::close();
 }
 
-std::unique_ptr<SOMAObject> SOMACollection::get(const std::string& key) {
-    auto tiledb_obj = SOMAGroup::get(key);
-    auto soma_obj = SOMAObject::open(
-        tiledb_obj.uri(), OpenMode::read, this->ctx(), this->timestamp());
+std::shared_ptr<SOMAObject> SOMACollection::get(const std::string& key) {
+    std::string uri;
+    {
+        std::lock_guard<std::mutex> lock(members_mutex_);
+        if (is_cached(key)) {
+            return cached_members_.at(key);
+        }
+        uri = SOMAGroup::get(key).uri();
+    }
+
+    std::shared_ptr<SOMAObject> soma_obj = SOMAObject::open(
+        uri, OpenMode::read, this->ctx(), this->timestamp());
+
+    // Another caller may have cached the member in the meantime
+    std::lock_guard<std::mutex> lock(members_mutex_);
+    if (is_cached(key)) {
+        return cached_members_.at(key);
+    }
+    cached_members_[key] = soma_obj;
     return soma_obj;
 }
 
+std::vector<std::shared_ptr<SOMAObject>> SOMACollection::open_all(
+    const std::vector<std::string>& keys) {
+    std::vector<std::string> names = keys;
+    std::vector<std::string> missing;
+    std::vector<std::string> uris;
+    {
+        std::lock_guard<std::mutex> lock(members_mutex_);
+        if (names.empty()) {
+            for (auto& [name, entry] : members_map()) {
+                names.push_back(name);
+            }
+        }
+
+        // Resolve the URIs of the members to open, once per key
+        std::unordered_set<std::string> seen;
+        for (auto& name : names) {
+            if (!is_cached(name) && seen.insert(name).second) {
+                missing.push_back(name);
+                uris.push_back(SOMAGroup::get(name).uri());
+            }
+        }
+    }
+
+    // Each member open is a type probe, an array or group open and a
+    // metadata read, so open them concurrently
+    std::vector<std::shared_ptr<SOMAObject>> opened(missing.size());
+    std::vector<std::exception_ptr> errors(missing.size());
+    auto open_member = [&, ctx = ctx(), timestamp = timestamp()](size_t i) {
+        try {
+            opened[i] = SOMAObject::open(
+                uris[i], OpenMode::read, ctx, timestamp);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    auto& thread_pool = ctx()->thread_pool();
+    if (missing.size() <= 1 || thread_pool == nullptr) {
+        for (size_t i = 0; i < missing.size(); i++) {
+            open_member(i);
+        }
+    } else {
+        std::vector<ThreadPool::Task> tasks;
+        for (size_t i = 0; i < missing.size(); i++) {
+            tasks.emplace_back(thread_pool->execute([&open_member, i]() {
+                open_member(i);
+                return Status::Ok();
+            }));
+        }
+        thread_pool->wait_all(tasks);
+    }
+
+    // Keep the members that opened, unless another caller cached them in the
+    // meantime, then report the first failure
+    std::lock_guard<std::mutex> lock(members_mutex_);
+    for (size_t i = 0; i < missing.size(); i++) {
+        if (opened[i] != nullptr && !is_cached(missing[i])) {
+            cached_members_[missing[i]] = opened[i];
+        }
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<std::shared_ptr<SOMAObject>> members;
+    for (auto& name : names) {
+        members.push_back(cached_members_.at(name));
+    }
+    return members;
+}
+
 std::shared_ptr<SOMACollection> SOMACollection::add_new_collection(
     std::string_view key,
     std::string_view uri,
@@ -101,6 +197,7 @@ std::shared_ptr<SOMACollection> SOMACollection::add_new_collection(
     // in addition to returning the SOMA object to the user.
     std::shared_ptr<SOMACollection> member = SOMACollection::open(
         uri, OpenMode::read, ctx, timestamp);
+    std::lock_guard<std::mutex> lock(members_mutex_);
     this->set(std::string(uri), uri_type, std::string(key), "SOMAGroup");
     children_[std::string(key)] = member;
     return member;
@@ -133,6 +230,7 @@ std::shared_ptr<SOMAExperiment> SOMACollection::add_new_experiment(
     // in addition to returning the SOMA object to the user.
     std::shared_ptr<SOMAExperiment> member = SOMAExperiment::open(
         uri, OpenMode::read, ctx, timestamp);
+    std::lock_guard<std::mutex> lock(members_mutex_);
     this->set(std::string(uri), uri_type, std::string(key), "SOMAGroup");
     children_[std::string(key)] = member;
     return member;
@@ -165,6 +263,7 @@ std::shared_ptr<SOMAMeasurement> SOMACollection::add_new_measurement(
     // in addition to returning the SOMA object to the user.
     std::shared_ptr<SOMAMeasurement> member = SOMAMeasurement::open(
         uri, OpenMode::read, ctx, timestamp);
+    std::lock_guard<std::mutex> lock(members_mutex_);
     this->set(std::string(uri), uri_type, std::string(key), "SOMAGroup");
     children_[std::string(key)] = member;
     return member;
@@ -199,6 +298,7 @@ std::shared_ptr<SOMADataFrame> SOMACollection::add_new_dataframe(
     // in addition to returning the SOMA object to the user.
     std::shared_ptr<SOMADataFrame> member = SOMADataFrame::open(
         uri, OpenMode::read, ctx, column_names, result_order, timestamp);
+    std::lock_guard<std::mutex> lock(members_mutex_);
     this->set(std::string(uri), uri_type, std::string(key), "SOMAArray");
     children_[std::string(key)] = member;
     return member;
@@ -233,6 +333,7 @@ std::shared_ptr<SOMADenseNDArray> SOMACollection::add_new_dense_ndarray(
     // in addition to returning the SOMA object to the user.
     std::shared_ptr<SOMADenseNDArray> member = SOMADenseNDArray::open(
         uri, OpenMode::read, ctx, column_names, result_order, timestamp);
+    std::lock_guard<std::mutex> lock(members_mutex_);
     this->set(std::string(uri), uri_type, std::string(key), "SOMAArray");
     children_[std::string(key)] = member;
     return member;
@@ -267,9 +368,21 @@ std::shared_ptr<SOMASparseNDArray> SOMACollection::add_new_sparse_ndarray(
     // in addition to returning the SOMA object to the user.
     std::shared_ptr<SOMASparseNDArray> member = SOMASparseNDArray::open(
         uri, OpenMode::read, ctx, column_names, result_order, timestamp);
+    std::lock_guard<std::mutex> lock(members_mutex_);
     this->set(std::string(uri), uri_type, std::string(key), "SOMAArray");
     children_[std::string(key)] = member;
     return member;
 }
 
+//===================================================================
+//= private non-static
+//===================================================================
+
+bool SOMACollection::is_cached(const std::string& key) const {
+    // Callers may have closed a cached member or reopened it for write
+    auto it = cached_members_.find(key);
+    return it != cached_members_.end() && it->second->is_open() &&
+           it->second->mode() == OpenMode::read;
+}
+
 }  // namespace tiledbsoma
@@ -33,6 +33,7 @@
 #ifndef SOMA_COLLECTION
 #define SOMA_COLLECTION
 
+#include <mutex>
 #include <tiledb/tiledb>
 
 #include "enums.h"
@@ -112,8 +113,11 @@ class SOMACollection : public SOMAGroup {
     }
 
     SOMACollection() = delete;
-    SOMACollection(const SOMACollection&) = default;
-    SOMACollection(SOMACollection&&) = default;
+    SOMACollection(const SOMACollection& other)
+        : SOMAGroup(other) {
+        std::lock_guard<std::mutex> lock(other.members_mutex_);
+        children_ = other.children_;
+    }
     ~SOMACollection() = default;
 
     using iterator =
@@ -128,16 +132,32 @@ class SOMACollection : public SOMAGroup {
     using SOMAGroup::open;
 
     /**
-     * Closes the SOMACollection object.
+     * Closes the SOMACollection object and the members added to it. Members
+     * returned by get and open_all may still be held by callers, so they are
+     * only dropped from the cache and stay open until released or closed.
      */
     void close();
 
     /**
-     * Get the SOMAObject associated with the key.
+     * Get the SOMAObject associated with the key, opened for read at the
+     * timestamp of the SOMACollection. The member is cached, so later calls
+     * return the same object, shared by all callers, until it is closed or
+     * the SOMACollection is closed. Members added by add_new_* are never
+     * returned nor replaced.
      *
      * @param key of member
      */
-    std::unique_ptr<SOMAObject> get(const std::string& key);
+    std::shared_ptr<SOMAObject> get(const std::string& key);
+
+    /**
+     * Get the SOMAObjects associated with the keys, as get does. Members not
+     * cached yet are opened concurrently on the context thread pool.
+     *
+     * @param keys of members, all members if empty
+     * @return the members, in the order of the keys
+     */
+    std::vector<std::shared_ptr<SOMAObject>> open_all(
+        const std::vector<std::string>& keys = {});
 
     /**
      * Create and add a SOMACollection to the SOMACollection.
@@ -278,6 +298,23 @@ class SOMACollection : public SOMAGroup {
 
     // Members of the SOMACollection
     std::map<std::string, std::shared_ptr<SOMAObject>> children_;
+
+    // Members opened for read by get and open_all
+    std::map<std::string, std::shared_ptr<SOMAObject>> cached_members_;
+
+    // Guards children_ and cached_members_
+    mutable std::mutex members_mutex_;
+
+   private:
+    //===================================================================
+    //= private non-static
+    //===================================================================
+
+    /**
+     * Whether the member associated with the key is cached and still open
+     * for read. Must be called with members_mutex_ held.
+     */
+    bool is_cached(const std::string& key) const;
 };
 }  // namespace tiledbsoma
 
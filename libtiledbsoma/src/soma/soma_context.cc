@@ -31,6 +31,8 @@
  */
 #include "soma_context.h"
 #include <thread_pool/thread_pool.h>
+#include <algorithm>
+#include <list>
 
 namespace tiledbsoma {
 
@@ -50,4 +52,44 @@ std::shared_ptr<ThreadPool>& SOMAContext::thread_pool() {
     }
     return thread_pool_;
 }
+
+namespace {
+// Contexts shared through SOMAContext::cached, by normalized config, most
+// recently used first
+std::mutex context_cache_mutex;
+std::list<std::pair<
+    std::map<std::string, std::string>,
+    std::shared_ptr<SOMAContext>>>
+    context_cache;
+}  // namespace
+
+std::shared_ptr<SOMAContext> SOMAContext::cached(
+    const std::map<std::string, std::string>& tiledb_config) {
+    // Expand the config with the defaults of every parameter not set
+    std::map<std::string, std::string> key;
+    for (auto& it : Config(tiledb_config))
+        key[it.first] = it.second;
+
+    const std::lock_guard<std::mutex> lock(context_cache_mutex);
+    auto it = std::find_if(
+        context_cache.begin(), context_cache.end(), [&](const auto& entry) {
+            return entry.first == key;
+        });
+    if (it != context_cache.end()) {
+        context_cache.splice(context_cache.begin(), context_cache, it);
+        return it->second;
+    }
+
+    auto ctx = std::make_shared<SOMAContext>(tiledb_config);
+    context_cache.emplace_front(std::move(key), ctx);
+    if (context_cache.size() > MAX_CACHED_CONTEXTS) {
+        context_cache.pop_back();
+    }
+    return ctx;
+}
+
+void SOMAContext::clear_cache() {
+    const std::lock_guard<std::mutex> lock(context_cache_mutex);
+    context_cache.clear();
+}
 }  // namespace tiledbsoma
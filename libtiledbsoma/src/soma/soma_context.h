@@ -45,6 +45,9 @@ using namespace tiledb;
 
 class SOMAContext {
    public:
+    // Number of contexts kept by SOMAContext::cached
+    inline static const size_t MAX_CACHED_CONTEXTS = 4;
+
     //===================================================================
     //= public non-static
     //===================================================================
@@ -73,6 +76,30 @@ class SOMAContext {
 
     std::shared_ptr<ThreadPool>& thread_pool();
 
+    //===================================================================
+    //= public static
+    //===================================================================
+
+    /**
+     * @brief Get a SOMAContext shared by every caller passing an equivalent
+     * TileDB config, creating it on first use. The config is normalized
+     * with TileDB's defaults, so omitted keys and keys set to their default
+     * value share a context. The MAX_CACHED_CONTEXTS most recently used
+     * contexts keep their TileDB caches and thread pool alive; older ones
+     * are evicted, and released once no caller holds them.
+     *
+     * @param tiledb_config TileDB config parameters
+     * @return std::shared_ptr<SOMAContext>
+     */
+    static std::shared_ptr<SOMAContext> cached(
+        const std::map<std::string, std::string>& tiledb_config = {});
+
+    /**
+     * @brief Drop the contexts held by the cache. Contexts still in use are
+     * released when their last user lets go of them.
+     */
+    static void clear_cache();
+
    private:
     //===================================================================
     //= private non-static
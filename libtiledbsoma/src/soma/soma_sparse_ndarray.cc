@@ -31,6 +31,8 @@
  */
 
 #include "soma_sparse_ndarray.h"
+#include <limits>
+#include "../utils/logger.h"
 
 namespace tiledbsoma {
 using namespace tiledb;
@@ -118,4 +120,255 @@ bool SOMASparseNDArray::exists(std::string_view uri) {
 std::unique_ptr<ArrowSchema> SOMASparseNDArray::schema() const {
     return this->arrow_schema();
 }
+
+std::shared_ptr<ArrayBuffers> SOMASparseNDArray::reduce_axis(uint64_t axis) {
+    auto dim_names = dimension_names();
+    if (axis >= dim_names.size()) {
+        throw TileDBSOMAError(fmt::format(
+            "[SOMASparseNDArray] reduce_axis: axis {} out of range for {} "
+            "dimensions",
+            axis,
+            dim_names.size()));
+    }
+    const auto& dim_name = dim_names[axis];
+    if (tiledb_schema()->domain().dimension(dim_name).type() != TILEDB_INT64) {
+        throw TileDBSOMAError(fmt::format(
+            "[SOMASparseNDArray] reduce_axis: dimension '{}' is not int64",
+            dim_name));
+    }
+
+    // Index the results by the non-empty domain of the dimension
+    int64_t first_index = 0;
+    size_t length = 0;
+    if (nnz() > 0) {
+        auto [lo, hi] = non_empty_domain<int64_t>(dim_name);
+        first_index = lo;
+        length = static_cast<size_t>(hi - lo + 1);
+    }
+
+    AxisReduction result(length);
+
+    auto data_type = tiledb_schema()->attribute("soma_data").type();
+    while (auto batch = read_next()) {
+        if (!(*batch)->contains(dim_name) ||
+            !(*batch)->contains("soma_data")) {
+            throw TileDBSOMAError(fmt::format(
+                "[SOMASparseNDArray] reduce_axis: '{}' and 'soma_data' must "
+                "be selected",
+                dim_name));
+        }
+
+        switch (data_type) {
+            case TILEDB_INT8:
+                accumulate_axis<int8_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_UINT8:
+            case TILEDB_BOOL:
+                accumulate_axis<uint8_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_INT16:
+                accumulate_axis<int16_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_UINT16:
+                accumulate_axis<uint16_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_INT32:
+                accumulate_axis<int32_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_UINT32:
+                accumulate_axis<uint32_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_INT64:
+                accumulate_axis<int64_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_UINT64:
+                accumulate_axis<uint64_t>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_FLOAT32:
+                accumulate_axis<float>(
+                    **batch, dim_name, first_index, result);
+                break;
+            case TILEDB_FLOAT64:
+                accumulate_axis<double>(
+                    **batch, dim_name, first_index, result);
+                break;
+            default:
+                throw TileDBSOMAError(
+                    "[SOMASparseNDArray] reduce_axis: soma_data is not "
+                    "numeric");
+        }
+    }
+
+    std::vector<int64_t> joinids(length);
+    for (size_t i = 0; i < length; i++) {
+        joinids[i] = first_index + static_cast<int64_t>(i);
+    }
+
+    auto make_column = [length](
+                           const std::string& name,
+                           tiledb_datatype_t type,
+                           const void* data,
+                           bool nullable = false) {
+        auto column = std::make_shared<ColumnBuffer>(
+            name,
+            type,
+            length,
+            length * tiledb::impl::type_size(type),
+            false,
+            nullable);
+        column->set_data(length, data);
+        return column;
+    };
+
+    auto buffers = std::make_shared<ArrayBuffers>();
+    buffers->emplace(
+        "soma_joinid",
+        make_column("soma_joinid", TILEDB_INT64, joinids.data()));
+    buffers->emplace(
+        "nnz", make_column("nnz", TILEDB_UINT64, result.nnz.data()));
+    buffers->emplace(
+        "sum", make_column("sum", TILEDB_FLOAT64, result.sum.data()));
+    buffers->emplace(
+        "sum_sq", make_column("sum_sq", TILEDB_FLOAT64, result.sum_sq.data()));
+
+    // Indexes without cells have no min or max
+    for (auto& [name, values] : {
+             std::pair{"min", &result.min}, std::pair{"max", &result.max}}) {
+        auto column = make_column(name, TILEDB_FLOAT64, values->data(), true);
+        auto validity = column->validity();
+        for (size_t i = 0; i < length; i++) {
+            validity[i] = result.nnz[i] > 0;
+        }
+        buffers->emplace(name, column);
+    }
+    return buffers;
+}
+
+//===================================================================
+//= private non-static
+//===================================================================
+
+SOMASparseNDArray::AxisReduction::AxisReduction(size_t length)
+    : nnz(length, 0)
+    , sum(length, 0)
+    , sum_sq(length, 0)
+    , min(length, std::numeric_limits<double>::infinity())
+    , max(length, -std::numeric_limits<double>::infinity()) {
+}
+
+template <typename T>
+void SOMASparseNDArray::accumulate_axis(
+    ArrayBuffers& batch,
+    const std::string& dim_name,
+    int64_t first_index,
+    AxisReduction& result) {
+    auto coords = batch.at(dim_name)->data<int64_t>();
+    auto values = batch.at("soma_data")->data<T>();
+    size_t num_cells = coords.size();
+    size_t length = result.nnz.size();
+
+    // The indexes are split into one slice per task, so no two tasks write
+    // the same accumulator
+    auto& thread_pool = ctx()->thread_pool();
+    size_t num_tasks = 1;
+    if (thread_pool != nullptr) {
+        num_tasks = std::min(
+            {thread_pool->concurrency_level(),
+             std::max<size_t>(1, num_cells / MIN_CELLS_PER_TASK),
+             std::max<size_t>(1, length)});
+    }
+
+    auto accumulate = [&](size_t i) {
+        auto index = static_cast<size_t>(coords[i] - first_index);
+        auto value = static_cast<double>(values[i]);
+        result.nnz[index]++;
+        result.sum[index] += value;
+        result.sum_sq[index] += value * value;
+        result.min[index] = std::min(result.min[index], value);
+        result.max[index] = std::max(result.max[index], value);
+    };
+
+    if (num_tasks == 1) {
+        for (size_t i = 0; i < num_cells; i++) {
+            if (static_cast<size_t>(coords[i] - first_index) < length) {
+                accumulate(i);
+            }
+        }
+        return;
+    }
+
+    auto run_tasks = [&thread_pool, num_tasks](auto&& fn) {
+        std::vector<ThreadPool::Task> tasks;
+        for (size_t task = 0; task < num_tasks; task++) {
+            tasks.emplace_back(thread_pool->execute([&fn, task]() {
+                fn(task);
+                return Status::Ok();
+            }));
+        }
+        auto status = thread_pool->wait_all(tasks);
+        if (!status.ok()) {
+            throw TileDBSOMAError(fmt::format(
+                "[SOMASparseNDArray] reduce_axis: {}", status.message()));
+        }
+    };
+
+    // Partition the cells by slice once: each task counts the cells of a
+    // contiguous range per slice, then places them in the bucket of their
+    // slice, keeping cells outside of the indexes out of all buckets
+    size_t slice_size = (length + num_tasks - 1) / num_tasks;
+    auto slice_of = [&](size_t i) {
+        auto index = static_cast<size_t>(coords[i] - first_index);
+        return index < length ? index / slice_size : num_tasks;
+    };
+    std::vector<std::vector<size_t>> offsets(
+        num_tasks, std::vector<size_t>(num_tasks + 1, 0));
+    run_tasks([&](size_t task) {
+        auto& counts = offsets[task];
+        for (size_t i = task * num_cells / num_tasks;
+             i < (task + 1) * num_cells / num_tasks;
+             i++) {
+            counts[slice_of(i)]++;
+        }
+    });
+
+    // Prefix sum of the counts by slice, then by range
+    std::vector<size_t> bucket_starts(num_tasks + 1, 0);
+    size_t offset = 0;
+    for (size_t slice = 0; slice < num_tasks; slice++) {
+        bucket_starts[slice] = offset;
+        for (auto& counts : offsets) {
+            auto count = counts[slice];
+            counts[slice] = offset;
+            offset += count;
+        }
+    }
+    bucket_starts[num_tasks] = offset;
+
+    std::vector<size_t> buckets(offset);
+    run_tasks([&](size_t task) {
+        auto& cursors = offsets[task];
+        for (size_t i = task * num_cells / num_tasks;
+             i < (task + 1) * num_cells / num_tasks;
+             i++) {
+            auto slice = slice_of(i);
+            if (slice < num_tasks) {
+                buckets[cursors[slice]++] = i;
+            }
+        }
+    });
+
+    run_tasks([&](size_t slice) {
+        for (auto b = bucket_starts[slice]; b < bucket_starts[slice + 1]; b++) {
+            accumulate(buckets[b]);
+        }
+    });
+}
 }  // namespace tiledbsoma
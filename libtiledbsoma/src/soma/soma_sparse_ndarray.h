@@ -157,6 +157,51 @@ class SOMASparseNDArray : public SOMAArray {
      * @return std::unique_ptr<ArrowSchema>
      */
     std::unique_ptr<ArrowSchema> schema() const;
+
+    /**
+     * @brief Reduce soma_data along one axis in a single pass.
+     *
+     * Reads the cells selected on this array, with `set_dim_ranges`,
+     * `set_dim_points` and `set_condition`, and accumulates them per index of
+     * dimension `soma_dim_{axis}`. Large batches are split across the
+     * SOMAContext thread pool, each task owning a disjoint slice of the
+     * indexes, so the tasks share one set of accumulators without locking.
+     *
+     * The result has one row per index in the non-empty domain of the
+     * dimension, with the columns `soma_joinid`, `nnz`, `sum`, `sum_sq`,
+     * `min` and `max`. `min` and `max` are null for indexes without cells.
+     *
+     * @param axis The dimension to reduce onto
+     * @return std::shared_ptr<ArrayBuffers> The per-index reductions
+     */
+    std::shared_ptr<ArrayBuffers> reduce_axis(uint64_t axis);
+
+   private:
+    //===================================================================
+    //= private non-static
+    //===================================================================
+
+    // Per-index accumulators of reduce_axis
+    struct AxisReduction {
+        std::vector<uint64_t> nnz;
+        std::vector<double> sum;
+        std::vector<double> sum_sq;
+        std::vector<double> min;
+        std::vector<double> max;
+
+        AxisReduction(size_t length);
+    };
+
+    // Minimum number of cells accumulated by one reduce_axis task
+    static constexpr size_t MIN_CELLS_PER_TASK = 1 << 16;
+
+    // Accumulate soma_data of `batch`, splitting the indexes across tasks
+    template <typename T>
+    void accumulate_axis(
+        ArrayBuffers& batch,
+        const std::string& dim_name,
+        int64_t first_index,
+        AxisReduction& result);
 };
 }  // namespace tiledbsoma
 
@@ -0,0 +1,144 @@
+/**
+ * @file   write_behind.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the WriteBehind class.
+ */
+
+#include "write_behind.h"
+#include "../utils/logger.h"
+#include "managed_query.h"
+
+namespace tiledbsoma {
+
+WriteBehind::WriteBehind(
+    std::shared_ptr<Array> array,
+    std::shared_ptr<Context> ctx,
+    size_t max_queued)
+    : array_(array)
+    , ctx_(ctx)
+    , max_queued_(std::max<size_t>(1, max_queued))
+    , thread_([this]() { run(); }) {
+}
+
+WriteBehind::~WriteBehind() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        LOG_ERROR(fmt::format("[WriteBehind] Write failed: {}", e.what()));
+    }
+}
+
+void WriteBehind::push(
+    std::shared_ptr<ArrayBuffers> buffers, bool sort_coords) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_written_.wait(lock, [this] {
+        return batches_.size() < max_queued_ || error_ != nullptr;
+    });
+    rethrow_error();
+    if (closed_) {
+        throw TileDBSOMAError("[WriteBehind] Writer is closed");
+    }
+    batches_.push_back({std::move(buffers), sort_coords});
+    batch_queued_.notify_one();
+}
+
+void WriteBehind::check() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    rethrow_error();
+}
+
+void WriteBehind::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_written_.wait(lock, [this] {
+        return (batches_.empty() && !writing_) || error_ != nullptr;
+    });
+    rethrow_error();
+}
+
+void WriteBehind::close() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    batch_queued_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    rethrow_error();
+}
+
+void WriteBehind::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        batch_queued_.wait(
+            lock, [this] { return !batches_.empty() || closed_; });
+        if (batches_.empty()) {
+            return;
+        }
+        auto batch = std::move(batches_.front());
+        batches_.pop_front();
+        writing_ = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            ManagedQuery mq(array_, ctx_, "write_behind");
+            for (const auto& name : batch.buffers->names()) {
+                mq.set_column_data(batch.buffers->at(name));
+            }
+            mq.submit_write(batch.sort_coords);
+            LOG_DEBUG(fmt::format(
+                "[WriteBehind] Wrote {} cells", batch.buffers->num_rows()));
+        } catch (...) {
+            error = std::current_exception();
+        }
+        batch.buffers.reset();
+
+        lock.lock();
+        writing_ = false;
+        if (error) {
+            // The batches queued after a failed write are dropped
+            error_ = error;
+            batches_.clear();
+        }
+        batch_written_.notify_all();
+    }
+}
+
+void WriteBehind::rethrow_error() {
+    if (error_) {
+        auto error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace tiledbsoma
@@ -0,0 +1,159 @@
+/**
+ * @file   write_behind.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the WriteBehind class.
+ */
+
+#ifndef WRITE_BEHIND
+#define WRITE_BEHIND
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "array_buffers.h"
+
+namespace tiledbsoma {
+
+using namespace tiledb;
+
+/**
+ * @brief Writes batches of column buffers on a background thread, in the
+ * order they are queued, one fragment per batch.
+ *
+ * At most `max_queued` batches wait to be written: `push` blocks until one of
+ * them has been written. An error from a background write is rethrown by the
+ * next call to `push`, `flush` or `close`, and the batches queued after it
+ * are dropped.
+ */
+class WriteBehind {
+   public:
+    /**
+     * @brief Construct a new WriteBehind object and start its thread.
+     *
+     * @param array Sparse array opened in write mode
+     * @param ctx TileDB context
+     * @param max_queued Maximum number of batches waiting to be written
+     */
+    WriteBehind(
+        std::shared_ptr<Array> array,
+        std::shared_ptr<Context> ctx,
+        size_t max_queued);
+
+    WriteBehind() = delete;
+    WriteBehind(const WriteBehind&) = delete;
+    WriteBehind(WriteBehind&&) = delete;
+
+    /**
+     * @brief Write the queued batches and stop the thread. Errors are logged,
+     * call `close` to receive them.
+     */
+    ~WriteBehind();
+
+    /**
+     * @brief Queue a batch to be written.
+     *
+     * @param buffers Column buffers of the batch, owning their data
+     * @param sort_coords Write the batch unordered instead of in global order
+     */
+    void push(std::shared_ptr<ArrayBuffers> buffers, bool sort_coords);
+
+    /**
+     * @brief Rethrow the error of a failed background write, if any, without
+     * waiting.
+     */
+    void check();
+
+    /**
+     * @brief Wait until the queued batches have been written.
+     */
+    void flush();
+
+    /**
+     * @brief Write the queued batches and stop the thread.
+     */
+    void close();
+
+   private:
+    // A batch waiting to be written
+    struct Batch {
+        std::shared_ptr<ArrayBuffers> buffers;
+        bool sort_coords;
+    };
+
+    /**
+     * @brief Write the queued batches until the WriteBehind is closed.
+     */
+    void run();
+
+    /**
+     * @brief Rethrow and clear the error of a background write, if any.
+     * Requires `mutex_` to be held.
+     */
+    void rethrow_error();
+
+    // Array written to
+    std::shared_ptr<Array> array_;
+
+    // TileDB context
+    std::shared_ptr<Context> ctx_;
+
+    // Maximum number of batches waiting to be written
+    size_t max_queued_;
+
+    // Batches waiting to be written
+    std::deque<Batch> batches_;
+
+    // True while the thread writes a batch taken from `batches_`
+    bool writing_ = false;
+
+    // True once the thread has been asked to stop
+    bool closed_ = false;
+
+    // Error of the last failed background write
+    std::exception_ptr error_;
+
+    // Guards the members above
+    std::mutex mutex_;
+
+    // Notified when a batch is queued or the WriteBehind is closed
+    std::condition_variable batch_queued_;
+
+    // Notified when a batch has been written
+    std::condition_variable batch_written_;
+
+    // Background writer thread
+    std::thread thread_;
+};
+
+}  // namespace tiledbsoma
+
+#endif  // WRITE_BEHIND
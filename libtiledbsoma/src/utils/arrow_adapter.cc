@@ -31,6 +31,7 @@
  */
 
 #include "arrow_adapter.h"
+#include "../soma/array_buffers.h"
 #include "../soma/column_buffer.h"
 #include "../utils/logger.h"
 
@@ -827,11 +828,10 @@ ArrowAdapter::to_arrow(std::shared_ptr<ColumnBuffer> column) {
         // column does not contain enumerated values.
         if (enmr->type() == TILEDB_STRING_ASCII ||
             enmr->type() == TILEDB_STRING_UTF8 || enmr->type() == TILEDB_CHAR) {
-            auto dict_vec = enmr->as_vector<std::string>();
             column->convert_enumeration();
             dict_arr->buffers[1] = column->enum_offsets().data();
             dict_arr->buffers[2] = column->enum_string().data();
-            dict_arr->length = dict_vec.size();
+            dict_arr->length = column->enumeration_size();
         } else {
             auto [dict_data, dict_length] = _get_data_and_length(
                 *enmr, dict_arr->buffers[1]);
@@ -949,4 +949,35 @@ enum ArrowType ArrowAdapter::to_nanoarrow_type(std::string_view sv) {
             fmt::format("ArrowAdapter: Unsupported Arrow format: {} ", sv));
 }
 
+ArrowTable ArrowAdapter::to_arrow(std::shared_ptr<ArrayBuffers> buffers) {
+    auto names = buffers->names();
+    auto schema = std::make_unique<ArrowSchema>();
+    auto array = std::make_unique<ArrowArray>();
+
+    exitIfError(
+        ArrowSchemaInitFromType(schema.get(), NANOARROW_TYPE_STRUCT),
+        "Bad schema init");
+    exitIfError(ArrowSchemaSetName(schema.get(), ""), "Bad schema name");
+    exitIfError(
+        ArrowSchemaAllocateChildren(schema.get(), names.size()),
+        "Bad schema children alloc");
+    exitIfError(
+        ArrowArrayInitFromType(array.get(), NANOARROW_TYPE_STRUCT),
+        "Bad array init");
+    exitIfError(
+        ArrowArrayAllocateChildren(array.get(), names.size()),
+        "Bad array children alloc");
+
+    // The struct array and schema keep nanoarrow's release callbacks, which
+    // call the release callbacks of the column children moved in.
+    array->length = buffers->num_rows();
+    for (size_t i = 0; i < names.size(); i++) {
+        auto [child_array, child_schema] = to_arrow(buffers->at(names[i]));
+        ArrowArrayMove(child_array.get(), array->children[i]);
+        ArrowSchemaMove(child_schema.get(), schema->children[i]);
+    }
+
+    return {std::move(array), std::move(schema)};
+}
+
 }  // namespace tiledbsoma
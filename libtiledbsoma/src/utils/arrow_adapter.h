@@ -16,6 +16,7 @@ namespace tiledbsoma {
 using namespace tiledb;
 using json = nlohmann::json;
 
+class ArrayBuffers;
 class ColumnBuffer;
 
 /**
@@ -180,6 +181,14 @@ class ArrowAdapter {
     static std::pair<std::unique_ptr<ArrowArray>, std::unique_ptr<ArrowSchema>>
     to_arrow(std::shared_ptr<ColumnBuffer> column);
 
+    /**
+     * @brief Convert ArrayBuffers to an Arrow struct array, with one child
+     * per column, as a record batch.
+     *
+     * @return ArrowTable
+     */
+    static ArrowTable to_arrow(std::shared_ptr<ArrayBuffers> buffers);
+
     /**
      * @brief Create a an ArrowSchema from TileDB Schema
      *
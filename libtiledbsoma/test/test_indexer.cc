@@ -32,9 +32,14 @@
 
 #include <reindexer/reindexer.h>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
 #include <string>
 #include <tiledb/tiledb>
+#include <tiledbsoma/tiledbsoma>
 #include <unordered_map>
 #include <vector>
 #include "external/khash/khash.h"
@@ -142,4 +147,100 @@ TEST_CASE("C++ re-indexer") {
         }
     }
 }
+
+TEST_CASE("C++ re-indexer sorted keys") {
+    // A contiguous range, sorted keys with gaps, and sorted keys too sparse
+    // for a bitmap
+    std::vector<std::vector<int64_t>> key_sets = {
+        {10, 11, 12, 13, 14},
+        {-3, -1, 0, 4, 9, 100},
+        {-1000000, 0, 1000000}};
+    std::vector<int64_t> lookups = {
+        std::numeric_limits<int64_t>::min(),
+        -1000000,
+        -3,
+        -2,
+        -1,
+        0,
+        4,
+        9,
+        10,
+        12,
+        14,
+        15,
+        100,
+        1000000,
+        std::numeric_limits<int64_t>::max()};
+
+    for (const auto& keys : key_sets) {
+        tiledbsoma::IntIndexer indexer;
+        indexer.map_locations(keys);
+        std::vector<int64_t> results(lookups.size());
+        indexer.lookup(lookups, results);
+        for (size_t i = 0; i < lookups.size(); i++) {
+            auto it = std::find(keys.begin(), keys.end(), lookups[i]);
+            int64_t expected = it == keys.end() ? -1 : it - keys.begin();
+            REQUIRE(results[i] == expected);
+        }
+    }
+}
+
+TEST_CASE("C++ re-indexer key types") {
+    tiledbsoma::IntIndexer int32_indexer;
+    int32_indexer.map_locations(std::vector<int32_t>{5, -3, 7});
+    std::vector<int64_t> results(3);
+    int32_indexer.lookup(std::vector<int64_t>{7, -3, 1}, results);
+    REQUIRE(results == std::vector<int64_t>{2, 1, -1});
+
+    tiledbsoma::IntIndexer uint64_indexer;
+    uint64_indexer.map_locations(
+        std::vector<uint64_t>{std::numeric_limits<uint64_t>::max(), 3});
+    uint64_indexer.lookup(
+        std::vector<uint64_t>{3, std::numeric_limits<uint64_t>::max(), 4},
+        results);
+    REQUIRE(results == std::vector<int64_t>{1, 0, -1});
+
+    // Arrow string array buffers, with an offset into the data
+    std::string data = "..AAAC-1AAAG-1";
+    std::vector<uint32_t> offsets = {2, 8, 14};
+    tiledbsoma::IntIndexer string_indexer;
+    string_indexer.map_locations(data.data(), offsets.data(), 2);
+    string_indexer.lookup(
+        std::vector<std::string>{"AAAG-1", "", "AAAC-1"}, results);
+    REQUIRE(results == std::vector<int64_t>{1, -1, 0});
+    REQUIRE_THROWS_AS(
+        string_indexer.lookup(std::vector<int64_t>{1, 2, 3}, results),
+        std::runtime_error);
+    REQUIRE_THROWS_AS(
+        string_indexer.map_locations(std::vector<std::string>{"a", "a"}),
+        std::runtime_error);
+}
+
+TEST_CASE("C++ re-indexer parallel map") {
+    auto ctx = std::make_shared<tiledbsoma::SOMAContext>(
+        std::map<std::string, std::string>{
+            {"sm.compute_concurrency_level", "8"}});
+
+    // Enough keys for the hash table to be built in shards
+    std::vector<int64_t> keys(1 << 18);
+    std::iota(keys.begin(), keys.end(), -1000);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(0));
+
+    tiledbsoma::IntIndexer indexer(ctx);
+    indexer.map_locations(keys);
+
+    std::vector<int64_t> lookups(keys);
+    lookups.push_back(-1001);
+    std::vector<int64_t> results(lookups.size());
+    indexer.lookup(lookups, results);
+    for (size_t i = 0; i < keys.size(); i++) {
+        REQUIRE(results[i] == static_cast<int64_t>(i));
+    }
+    REQUIRE(results.back() == -1);
+
+    keys.back() = keys.front();
+    tiledbsoma::IntIndexer duplicate_indexer(ctx);
+    REQUIRE_THROWS_AS(
+        duplicate_indexer.map_locations(keys), std::runtime_error);
+}
 }  // namespace
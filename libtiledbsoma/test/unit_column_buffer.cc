@@ -98,4 +98,73 @@ TEST_CASE("ColumnBuffer: Create from array") {
         REQUIRE(buffers->is_var() == true);
         REQUIRE(buffers->is_nullable() == true);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("ColumnBuffer: Shared enumeration") {
+    std::string uri = "mem://unit-test-array";
+    auto ctx = Context();
+    auto array = create_array(uri, ctx);
+
+    auto enums = std::make_shared<EnumerationBuffers>(
+        std::vector<std::string>{"red", "blue", "green"});
+    REQUIRE(enums->data == "redbluegreen");
+    REQUIRE(enums->offsets == std::vector<uint32_t>{0, 3, 7, 12});
+
+    auto buffer1 = ColumnBuffer::create(array, "a1");
+    auto buffer2 = ColumnBuffer::create(array, "a1");
+    REQUIRE(!buffer1->has_enumeration());
+    buffer1->add_enumeration(enums);
+    buffer2->add_enumeration(enums);
+
+    REQUIRE(buffer1->has_enumeration());
+    REQUIRE(buffer1->enumeration_size() == 3);
+    REQUIRE(buffer1->enum_string().data() == buffer2->enum_string().data());
+    REQUIRE(buffer1->enum_offsets().size() == 4);
+    REQUIRE(buffer2->get_enumeration() == enums->values);
+}
+
+TEST_CASE("ColumnBuffer: Data view") {
+    // Fixed-size data is borrowed, the validity bitmap is expanded
+    std::vector<int32_t> values = {1, 2, 3, 4, 5};
+    uint8_t validity_bitmap = 0b10110;
+    ColumnBuffer fixed("a", TILEDB_INT32, 0, 0, false, true);
+    fixed.set_data_view(
+        4,
+        values.data() + 1,
+        static_cast<const uint64_t*>(nullptr),
+        &validity_bitmap,
+        1);
+    REQUIRE(fixed.size() == 4);
+    REQUIRE(fixed.data<int32_t>().data() == values.data() + 1);
+    auto validity = fixed.validity();
+    REQUIRE(
+        std::vector<uint8_t>(validity.begin(), validity.end()) ==
+        std::vector<uint8_t>{1, 1, 0, 1});
+
+    // 32-bit offsets of a slice are widened and rebased to its first string
+    std::string chars = "redbluegreen";
+    std::vector<uint32_t> offsets32 = {0, 3, 7, 12};
+    ColumnBuffer var32("s", TILEDB_STRING_UTF8, 0, 0, true);
+    var32.set_data_view(2, chars.data(), offsets32.data() + 1);
+    REQUIRE(var32.data_size() == 9);
+    REQUIRE(var32.data<char>().data() == chars.data() + 3);
+    auto widened = var32.offsets();
+    REQUIRE(
+        std::vector<uint64_t>(widened.begin(), widened.end()) ==
+        std::vector<uint64_t>{0, 4});
+
+    // 64-bit offsets starting at 0 are borrowed as well
+    std::vector<uint64_t> offsets64 = {0, 3, 7, 12};
+    ColumnBuffer var64("s", TILEDB_STRING_UTF8, 0, 0, true);
+    var64.set_data_view(3, chars.data(), offsets64.data());
+    REQUIRE(var64.data_size() == 12);
+    REQUIRE(var64.offsets().data() == offsets64.data());
+
+    // Booleans are expanded from bits to bytes
+    uint8_t bool_bitmap = 0b0101;
+    ColumnBuffer flags("b", TILEDB_BOOL, 0, 0);
+    flags.set_bitmap_data(3, &bool_bitmap, 1);
+    auto bytes = flags.data<uint8_t>();
+    REQUIRE(
+        std::vector<uint8_t>(bytes.begin(), bytes.end()) ==
+        std::vector<uint8_t>{0, 1, 0});
+}
@@ -0,0 +1,199 @@
+/**
+ * @file   unit_compressed_sparse_matrix.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file manages unit tests for compressed sparse matrices
+ */
+
+#include <reindexer/reindexer.h>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <tiledb/tiledb>
+#include <tiledbsoma/tiledbsoma>
+
+using namespace tiledb;
+using namespace tiledbsoma;
+
+namespace {
+
+/**
+ * @brief Create a batch of COO cells, as returned by SOMAArray::read_next.
+ */
+std::shared_ptr<ArrayBuffers> make_batch(
+    std::vector<int64_t> rows,
+    std::vector<int64_t> cols,
+    std::vector<float> data) {
+    auto batch = std::make_shared<ArrayBuffers>();
+    auto add_column = [&](const std::string& name,
+                          tiledb_datatype_t type,
+                          const void* values) {
+        auto column = std::make_shared<ColumnBuffer>(
+            name, type, rows.size(), rows.size() * 8);
+        column->set_data(rows.size(), values);
+        batch->emplace(name, column);
+    };
+    add_column("soma_dim_0", TILEDB_INT64, rows.data());
+    add_column("soma_dim_1", TILEDB_INT64, cols.data());
+    add_column("soma_data", TILEDB_FLOAT32, data.data());
+    return batch;
+}
+
+std::vector<float> values(CompressedSparseMatrix& matrix) {
+    auto data = reinterpret_cast<float*>(matrix.data().data());
+    return std::vector<float>(data, data + matrix.nnz());
+}
+
+}  // namespace
+
+TEST_CASE("CompressedSparseMatrix: CSR and CSC") {
+    auto ctx = std::make_shared<SOMAContext>();
+    bool csr = GENERATE(true, false);
+
+    CompressedSparseMatrix matrix(ctx, 3, 4, csr);
+    matrix.append(make_batch({2, 0, 0}, {1, 3, 0}, {1, 2, 3}));
+    matrix.append(make_batch({1, 2}, {2, 0}, {4, 5}));
+    REQUIRE_THROWS_AS(matrix.indptr(), TileDBSOMAError);
+    REQUIRE_THROWS_AS(matrix.indices(), TileDBSOMAError);
+    REQUIRE_THROWS_AS(matrix.data(), TileDBSOMAError);
+    matrix.compress();
+
+    REQUIRE(matrix.nnz() == 5);
+    REQUIRE(matrix.data_type() == TILEDB_FLOAT32);
+    if (csr) {
+        REQUIRE(matrix.indptr() == std::vector<int64_t>{0, 2, 3, 5});
+        REQUIRE(matrix.indices() == std::vector<int64_t>{0, 3, 2, 0, 1});
+        REQUIRE(values(matrix) == std::vector<float>{3, 2, 4, 5, 1});
+    } else {
+        REQUIRE(matrix.indptr() == std::vector<int64_t>{0, 2, 3, 4, 5});
+        REQUIRE(matrix.indices() == std::vector<int64_t>{0, 2, 2, 1, 0});
+        REQUIRE(values(matrix) == std::vector<float>{3, 5, 1, 4, 2});
+    }
+    REQUIRE_THROWS(matrix.append(make_batch({0}, {0}, {1})));
+}
+
+TEST_CASE("CompressedSparseMatrix: Reindex") {
+    auto ctx = std::make_shared<SOMAContext>();
+    auto row_indexer = std::make_shared<IntIndexer>(ctx);
+    row_indexer->map_locations(std::vector<int64_t>{30, 10, 20});
+
+    CompressedSparseMatrix matrix(ctx, 3, 2, true, row_indexer);
+    matrix.append(make_batch({10, 20, 30}, {1, 0, 1}, {1, 2, 3}));
+    matrix.compress();
+
+    REQUIRE(matrix.indptr() == std::vector<int64_t>{0, 1, 2, 3});
+    REQUIRE(matrix.indices() == std::vector<int64_t>{1, 1, 0});
+    REQUIRE(values(matrix) == std::vector<float>{3, 1, 2});
+
+    // Joinid 40 is not in the index
+    CompressedSparseMatrix missing(ctx, 3, 2, true, row_indexer);
+    REQUIRE_THROWS_AS(
+        missing.append(make_batch({10, 40}, {0, 0}, {1, 2})), TileDBSOMAError);
+}
+
+TEST_CASE("CompressedSparseMatrix: Out of bounds") {
+    auto ctx = std::make_shared<SOMAContext>();
+    CompressedSparseMatrix matrix(ctx, 2, 2);
+    REQUIRE_THROWS_AS(
+        matrix.append(make_batch({0, 1}, {0, 2}, {1, 2})), TileDBSOMAError);
+    REQUIRE_THROWS_AS(
+        matrix.append(make_batch({2}, {0}, {1})), TileDBSOMAError);
+
+    // Rejected batches are not counted
+    matrix.append(make_batch({1}, {1}, {3}));
+    matrix.compress();
+    REQUIRE(matrix.nnz() == 1);
+    REQUIRE(matrix.indptr() == std::vector<int64_t>{0, 0, 1});
+    REQUIRE(matrix.indices() == std::vector<int64_t>{1});
+}
+
+TEST_CASE("CompressedSparseMatrix: Reused batch buffers") {
+    auto ctx = std::make_shared<SOMAContext>();
+    CompressedSparseMatrix matrix(ctx, 2, 2);
+
+    // Appended cells are copied, so the batch can be overwritten by the
+    // next read
+    auto batch = make_batch({0, 1}, {1, 0}, {1, 2});
+    matrix.append(batch);
+    std::vector<int64_t> rows{1, 0};
+    std::vector<int64_t> cols{1, 0};
+    std::vector<float> data{3, 4};
+    batch->at("soma_dim_0")->set_data(2, rows.data());
+    batch->at("soma_dim_1")->set_data(2, cols.data());
+    batch->at("soma_data")->set_data(2, data.data());
+    matrix.append(batch);
+    matrix.compress();
+
+    REQUIRE(matrix.indptr() == std::vector<int64_t>{0, 2, 4});
+    REQUIRE(matrix.indices() == std::vector<int64_t>{0, 1, 0, 1});
+    REQUIRE(values(matrix) == std::vector<float>{4, 1, 2, 3});
+}
+
+TEST_CASE("CompressedSparseMatrix: Parallel counting sort") {
+    auto ctx = std::make_shared<SOMAContext>(
+        std::map<std::string, std::string>{
+            {"sm.compute_concurrency_level", "4"}});
+    bool csr = GENERATE(true, false);
+
+    // Enough cells for several tasks, appended column by column in reverse
+    const int64_t num_rows = 100;
+    const int64_t num_cols = 3000;
+    CompressedSparseMatrix matrix(ctx, num_rows, num_cols, csr);
+    for (int64_t batch = 2; batch >= 0; batch--) {
+        std::vector<int64_t> rows, cols;
+        std::vector<float> data;
+        for (int64_t col = (batch + 1) * 1000 - 1; col >= batch * 1000;
+             col--) {
+            for (int64_t row = 0; row < num_rows; row++) {
+                rows.push_back(row);
+                cols.push_back(col);
+                data.push_back(static_cast<float>(col * num_rows + row));
+            }
+        }
+        matrix.append(make_batch(rows, cols, data));
+    }
+    matrix.compress();
+
+    REQUIRE(matrix.nnz() == num_rows * num_cols);
+    auto num_major = csr ? num_rows : num_cols;
+    auto num_minor = csr ? num_cols : num_rows;
+    auto& indptr = matrix.indptr();
+    auto& indices = matrix.indices();
+    auto data = values(matrix);
+    bool all_match = true;
+    for (int64_t m = 0; m < num_major; m++) {
+        all_match &= indptr[m] == m * num_minor;
+        for (int64_t n = 0; n < num_minor; n++) {
+            auto row = csr ? m : n;
+            auto col = csr ? n : m;
+            all_match &= indices[m * num_minor + n] == n;
+            all_match &= data[m * num_minor + n] ==
+                         static_cast<float>(col * num_rows + row);
+        }
+    }
+    REQUIRE(all_match);
+}
@@ -39,6 +39,7 @@
 #include <catch2/matchers/catch_matchers_templated.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 #include <random>
+#include <set>
 
 #include <tiledb/tiledb>
 #include <tiledbsoma/tiledbsoma>
@@ -184,3 +185,143 @@ TEST_CASE("ManagedQuery: Validity test") {
     REQUIRE_THAT(a0, Equals(mq.strings("a0")));
     REQUIRE_THAT(a0_valids, Equals(a0_valids_actual));
 }
+
+TEST_CASE("ManagedQuery: Retry with larger buffers") {
+    std::string uri = "mem://unit-test-array-retry";
+    auto ctx = std::make_shared<Context>(
+        Config({{"soma.init_buffer_bytes", "64"}}));
+    auto [array, d0, a0, _] = create_array(uri, *ctx);
+
+    // Overwrite one cell with a value that is larger than the initial buffer
+    std::string big_value(200, 'X');
+    {
+        Array writer(*ctx, uri, TILEDB_WRITE);
+        std::vector<std::string> d0_big = {"a"};
+        std::vector<std::string> a0_big = {big_value};
+        auto [d0_data, d0_offsets] = util::to_varlen_buffers(d0_big, false);
+        auto [a0_data, a0_offsets] = util::to_varlen_buffers(a0_big, false);
+        std::vector<uint8_t> a0_valids = {1};
+        Query query(*ctx, writer);
+        query.set_layout(TILEDB_UNORDERED)
+            .set_data_buffer("d0", d0_data)
+            .set_offsets_buffer("d0", d0_offsets)
+            .set_data_buffer("a0", a0_data)
+            .set_offsets_buffer("a0", a0_offsets)
+            .set_validity_buffer("a0", a0_valids);
+        query.submit();
+        writer.close();
+    }
+    array = std::make_shared<Array>(*ctx, uri, TILEDB_READ);
+
+    auto mq = ManagedQuery(array, ctx);
+    mq.select_columns({"a0"});
+    mq.select_points<std::string>("d0", {"a"});
+    mq.setup_read();
+    mq.submit_read();
+    mq.results();
+
+    REQUIRE(mq.total_num_cells() == 1);
+    REQUIRE(std::string(mq.string_view("a0", 0)) == big_value);
+    REQUIRE(mq.buffer_sizes()["a0"] >= big_value.size());
+}
+
+TEST_CASE("ManagedQuery: Prefetch test") {
+    std::string uri = "mem://unit-test-array-prefetch";
+    auto ctx = std::make_shared<Context>(
+        Config({{"soma.init_buffer_bytes", "16"}}));
+    auto [array, d0, a0, _] = create_array(uri, *ctx);
+
+    auto mq = ManagedQuery(array, ctx);
+    mq.set_prefetch(true);
+    REQUIRE(mq.prefetch());
+
+    std::vector<std::string> d0_actual;
+    std::vector<std::string> a0_actual;
+    size_t num_batches = 0;
+    while (!mq.is_complete(true)) {
+        mq.setup_read();
+        mq.submit_read();
+        mq.results();
+        auto d0_batch = mq.strings("d0");
+        auto a0_batch = mq.strings("a0");
+        d0_actual.insert(d0_actual.end(), d0_batch.begin(), d0_batch.end());
+        a0_actual.insert(a0_actual.end(), a0_batch.begin(), a0_batch.end());
+        num_batches++;
+    }
+
+    REQUIRE(num_batches > 1);
+    REQUIRE(mq.total_num_cells() == d0.size());
+    REQUIRE_THAT(d0, Equals(d0_actual));
+    REQUIRE_THAT(a0, Equals(a0_actual));
+}
+
+TEST_CASE("ManagedQuery: Read budget test") {
+    std::string uri = "mem://unit-test-array-budget";
+    auto ctx = std::make_shared<Context>(
+        Config({{"soma.read_budget_bytes", "64"}}));
+    auto [array, d0, a0, _] = create_array(uri, *ctx);
+
+    auto mq = ManagedQuery(array, ctx);
+    std::vector<std::string> d0_actual;
+    std::vector<std::string> a0_actual;
+    size_t num_batches = 0;
+    while (!mq.is_complete(true)) {
+        mq.setup_read();
+        mq.submit_read();
+        auto results = mq.results();
+
+        // All columns hold the same number of cells
+        REQUIRE(
+            results->at("d0")->cell_capacity() ==
+            results->at("a0")->cell_capacity());
+
+        auto d0_batch = mq.strings("d0");
+        auto a0_batch = mq.strings("a0");
+        d0_actual.insert(d0_actual.end(), d0_batch.begin(), d0_batch.end());
+        a0_actual.insert(a0_actual.end(), a0_batch.begin(), a0_batch.end());
+        num_batches++;
+    }
+
+    REQUIRE(num_batches > 1);
+    REQUIRE_THAT(d0, Equals(d0_actual));
+    REQUIRE_THAT(a0, Equals(a0_actual));
+}
+
+TEST_CASE("ManagedQuery: Buffer reuse test") {
+    std::string uri = "mem://unit-test-array-reuse";
+    auto ctx = std::make_shared<Context>(
+        Config({{"soma.read_budget_bytes", "64"}}));
+    auto [array, d0, a0, _] = create_array(uri, *ctx);
+
+    auto mq = ManagedQuery(array, ctx);
+
+    // Results released by the caller are reused for the next batch
+    std::vector<std::string> d0_actual;
+    std::set<ColumnBuffer*> released_buffers;
+    size_t num_batches = 0;
+    while (!mq.is_complete(true)) {
+        mq.setup_read();
+        mq.submit_read();
+        auto results = mq.results();
+        released_buffers.insert(results->at("d0").get());
+
+        auto d0_batch = mq.strings("d0");
+        d0_actual.insert(d0_actual.end(), d0_batch.begin(), d0_batch.end());
+        num_batches++;
+    }
+    REQUIRE(num_batches > 1);
+    REQUIRE(released_buffers.size() == 1);
+    REQUIRE_THAT(d0, Equals(d0_actual));
+
+    // Results held by the caller are not reused
+    mq.reset();
+    std::vector<std::shared_ptr<ArrayBuffers>> held_results;
+    std::set<ColumnBuffer*> held_buffers;
+    while (!mq.is_complete(true)) {
+        mq.setup_read();
+        mq.submit_read();
+        held_results.push_back(mq.results());
+        held_buffers.insert(held_results.back()->at("d0").get());
+    }
+    REQUIRE(held_buffers.size() == num_batches);
+}
@@ -39,8 +39,10 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <catch2/matchers/catch_matchers_templated.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
+#include <algorithm>
 #include <numeric>
 #include <random>
+#include <set>
 
 #include <tiledb/tiledb>
 #include <tiledbsoma/tiledbsoma>
@@ -361,6 +363,189 @@ TEST_CASE("SOMAArray: nnz with consolidation") {
     }
 }
 
+TEST_CASE("SOMAArray: nnz count aggregate") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string base_uri = "mem://unit-test-array-nnz-count";
+    const auto& [uri, expected_nnz] = create_array(base_uri, ctx, 16, 4);
+
+    // Rewrite the same cells, then consolidate so nnz() can no longer sum
+    // fragment cell counts and must count the cells
+    write_array(uri, ctx, 16, 4, false, 10);
+    write_array(uri, ctx, 16, 4, false, 20);
+    Array::consolidate(*ctx->tiledb_ctx(), uri);
+
+    auto soma_array = SOMAArray::open(
+        OpenMode::read,
+        uri,
+        ctx,
+        "nnz",
+        {},
+        "auto",
+        ResultOrder::automatic,
+        TimestampRange(0, 30));
+    REQUIRE(soma_array->nnz() == expected_nnz);
+
+    // The cached value is returned until the array is reopened
+    REQUIRE(soma_array->nnz() == expected_nnz);
+
+    // A partial timestamp range only sees the first fragment written at 10
+    soma_array->open(OpenMode::read, TimestampRange(10, 10));
+    REQUIRE(soma_array->nnz() == 16);
+    soma_array->close();
+}
+
+TEST_CASE("SOMAArray: aggregate") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string base_uri = "mem://unit-test-array-aggregate";
+    const auto& [uri, expected_nnz] = create_array(base_uri, ctx, 10, 4);
+    write_array(uri, ctx, 10, 4);
+
+    auto soma_array = SOMAArray::open(OpenMode::read, uri, ctx);
+
+    // Fragment i writes a0 = i to the cells d0 = 10 * i ... 10 * i + 9
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::count) ==
+        AggregateValue{expected_nnz});
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::sum) ==
+        AggregateValue{int64_t{60}});
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::mean) ==
+        AggregateValue{1.5});
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::min) ==
+        AggregateValue{int64_t{0}});
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::max) ==
+        AggregateValue{int64_t{3}});
+    REQUIRE(
+        soma_array->aggregate("d0", AggregateOp::sum) ==
+        AggregateValue{int64_t{780}});
+
+    auto qc = QueryCondition::create<int>(
+        *ctx->tiledb_ctx(), "a0", 2, TILEDB_GE);
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::count, qc) ==
+        AggregateValue{uint64_t{20}});
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::sum, qc) ==
+        AggregateValue{int64_t{50}});
+    REQUIRE(
+        soma_array->aggregate("d0", AggregateOp::min, qc) ==
+        AggregateValue{int64_t{20}});
+
+    auto empty = QueryCondition::create<int>(
+        *ctx->tiledb_ctx(), "a0", 4, TILEDB_GE);
+    REQUIRE(
+        soma_array->aggregate("a0", AggregateOp::sum, empty) ==
+        AggregateValue{int64_t{0}});
+    REQUIRE(!soma_array->aggregate("a0", AggregateOp::max, empty));
+
+    REQUIRE_THROWS_AS(
+        soma_array->aggregate("a1", AggregateOp::sum), TileDBSOMAError);
+    soma_array->close();
+}
+
+TEST_CASE("SOMAArray: Global order write") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string base_uri = "mem://unit-test-array-global-order-write";
+    auto [uri, expected_nnz] = create_array(base_uri, ctx);
+
+    auto soma_array = SOMAArray::open(OpenMode::write, uri, ctx);
+    soma_array->begin_global_order_write();
+    REQUIRE_THROWS_AS(
+        soma_array->begin_global_order_write(), TileDBSOMAError);
+
+    // Three sorted batches, appended to the same query
+    for (int batch = 0; batch < 3; batch++) {
+        std::vector<int64_t> d0(10);
+        std::iota(d0.begin(), d0.end(), batch * 10);
+        std::vector<int> a0(10, batch);
+        soma_array->set_column_data("a0", a0.size(), a0.data());
+        soma_array->set_column_data("d0", d0.size(), d0.data());
+        soma_array->write(false);
+    }
+    soma_array->end_global_order_write();
+    soma_array->close();
+
+    // All the batches were written to a single fragment
+    FragmentInfo fragment_info(*ctx->tiledb_ctx(), uri);
+    fragment_info.load();
+    REQUIRE(fragment_info.fragment_num() == 1);
+
+    soma_array->open(OpenMode::read);
+    REQUIRE(soma_array->nnz() == 30);
+    soma_array->close();
+
+    // Batches written during a global order write are not sorted
+    soma_array->open(OpenMode::write);
+    soma_array->begin_global_order_write();
+    std::vector<int64_t> d0{40, 41};
+    std::vector<int> a0{4, 4};
+    soma_array->set_column_data("a0", a0.size(), a0.data());
+    soma_array->set_column_data("d0", d0.size(), d0.data());
+    REQUIRE_THROWS_AS(soma_array->write(), TileDBSOMAError);
+
+    // Ending a global order write without batches writes nothing
+    soma_array->end_global_order_write();
+    soma_array->begin_global_order_write();
+    soma_array->close();
+    fragment_info.load();
+    REQUIRE(fragment_info.fragment_num() == 1);
+}
+
+TEST_CASE("SOMAArray: Write behind") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string base_uri = "mem://unit-test-array-write-behind";
+    auto [uri, expected_nnz] = create_array(base_uri, ctx);
+
+    auto soma_array = SOMAArray::open(OpenMode::write, uri, ctx);
+    soma_array->set_write_behind(20, 0);
+    REQUIRE_THROWS_AS(
+        soma_array->begin_global_order_write(), TileDBSOMAError);
+
+    // Five batches of 10 cells, released as soon as they are written
+    for (int batch = 0; batch < 5; batch++) {
+        std::vector<int64_t> d0(10);
+        std::iota(d0.begin(), d0.end(), batch * 10);
+        std::vector<int> a0(10, batch);
+        soma_array->set_column_data("a0", a0.size(), a0.data());
+        soma_array->set_column_data("d0", d0.size(), d0.data());
+        soma_array->write();
+    }
+    soma_array->flush_writes();
+    soma_array->close();
+
+    // Batches were accumulated by 20 cells, and the rest written on flush
+    FragmentInfo fragment_info(*ctx->tiledb_ctx(), uri);
+    fragment_info.load();
+    REQUIRE(fragment_info.fragment_num() == 3);
+
+    soma_array->open(OpenMode::read);
+    REQUIRE(soma_array->nnz() == 50);
+    soma_array->close();
+
+    // Sorted batches with overlapping ranges are accumulated and written
+    // unordered
+    soma_array->open(OpenMode::write);
+    for (int batch = 0; batch < 2; batch++) {
+        std::vector<int64_t> d0(10);
+        for (int64_t i = 0; i < 10; i++) {
+            d0[i] = 50 + 2 * i + batch;
+        }
+        std::vector<int> a0(10, batch);
+        soma_array->set_column_data("a0", a0.size(), a0.data());
+        soma_array->set_column_data("d0", d0.size(), d0.data());
+        soma_array->write(false);
+    }
+    REQUIRE_NOTHROW(soma_array->flush_writes());
+    soma_array->close();
+
+    soma_array->open(OpenMode::read);
+    REQUIRE(soma_array->nnz() == 70);
+    soma_array->close();
+}
+
 TEST_CASE("SOMAArray: metadata") {
     auto ctx = std::make_shared<SOMAContext>();
     std::string base_uri = "mem://unit-test-array";
@@ -443,6 +628,173 @@ TEST_CASE("SOMAArray: Test buffer size") {
     soma_array->close();
 }
 
+TEST_CASE("SOMAArray: Arrow stream") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string base_uri = "mem://unit-test-array-arrow-stream";
+    auto [uri, expected_nnz] = create_array(base_uri, ctx);
+    auto [expected_d0, expected_a0] = write_array(uri, ctx);
+
+    std::shared_ptr<SOMAArray> soma_array = SOMAArray::open(
+        OpenMode::read, uri, ctx, "arrow_stream", {}, "3");
+    ArrowArrayStream stream;
+    SOMAArray::to_arrow_stream(soma_array, &stream);
+
+    ArrowSchema schema;
+    REQUIRE(stream.get_schema(&stream, &schema) == 0);
+    REQUIRE(schema.n_children == 2);
+    REQUIRE(std::string(schema.children[0]->name) == "d0");
+    REQUIRE(std::string(schema.children[1]->name) == "a0");
+    schema.release(&schema);
+
+    // One struct array per batch, until the stream ends
+    std::vector<int64_t> batch_rows;
+    std::vector<int64_t> d0;
+    while (true) {
+        ArrowArray batch;
+        REQUIRE(stream.get_next(&stream, &batch) == 0);
+        if (batch.release == nullptr) {
+            break;
+        }
+        REQUIRE(batch.n_children == 2);
+        batch_rows.push_back(batch.length);
+        auto d0_batch = static_cast<const int64_t*>(
+            batch.children[0]->buffers[1]);
+        d0.insert(d0.end(), d0_batch, d0_batch + batch.length);
+        batch.release(&batch);
+    }
+    REQUIRE(batch_rows == std::vector<int64_t>{3, 3, 3, 1});
+    REQUIRE(d0 == expected_d0);
+    REQUIRE(stream.get_last_error(&stream) == nullptr);
+
+    stream.release(&stream);
+    soma_array->close();
+}
+
+TEST_CASE("SOMAArray: Test batch size") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string base_uri = "mem://unit-test-array-batch-size";
+    auto [uri, expected_nnz] = create_array(base_uri, ctx);
+    auto [expected_d0, expected_a0] = write_array(uri, ctx);
+
+    auto soma_array = SOMAArray::open(
+        OpenMode::read, uri, ctx, "batch_size", {}, "3");
+    std::vector<uint64_t> batch_rows;
+    std::vector<int64_t> d0;
+    while (auto batch = soma_array->read_next()) {
+        batch_rows.push_back((*batch)->num_rows());
+        auto d0_batch = (*batch)->at("d0")->data<int64_t>();
+        d0.insert(d0.end(), d0_batch.begin(), d0_batch.end());
+    }
+    REQUIRE(batch_rows == std::vector<uint64_t>{3, 3, 3, 1});
+    REQUIRE(d0 == expected_d0);
+
+    REQUIRE_THROWS_AS(soma_array->reset({}, "three"), TileDBSOMAError);
+    REQUIRE_THROWS_AS(soma_array->reset({}, "0"), TileDBSOMAError);
+    soma_array->close();
+}
+
+TEST_CASE("SOMAArray: Point selection") {
+    auto point_selection = GENERATE(
+        PointSelection::automatic,
+        PointSelection::points,
+        PointSelection::ranges,
+        PointSelection::bounding_range);
+    auto num_chunks = GENERATE(1, 3);
+    int num_cells = 256;
+
+    std::ostringstream section;
+    section << "- point_selection=" << static_cast<int>(point_selection)
+            << " num_chunks=" << num_chunks;
+
+    SECTION(section.str()) {
+        auto ctx = std::make_shared<SOMAContext>();
+        std::string base_uri = "mem://unit-test-array-point-selection";
+        auto [uri, expected_nnz] = create_array(base_uri, ctx, num_cells);
+        write_array(uri, ctx, num_cells);
+
+        // Even points, unsorted, and a run of consecutive points with
+        // duplicates
+        std::vector<int64_t> points;
+        for (int64_t i = num_cells - 2; i >= 0; i -= 2) {
+            points.push_back(i);
+        }
+        for (int64_t i = 100; i < 110; i++) {
+            points.push_back(i);
+        }
+        std::set<int64_t> expected(points.begin(), points.end());
+
+        auto soma_array = SOMAArray::open(OpenMode::read, uri, ctx);
+        soma_array->set_point_selection(point_selection);
+
+        // Points selected by several calls, as for a chunked Arrow array,
+        // are all read
+        size_t chunk_size = (points.size() + num_chunks - 1) / num_chunks;
+        for (size_t start = 0; start < points.size(); start += chunk_size) {
+            auto end = std::min(points.size(), start + chunk_size);
+            soma_array->set_dim_points(
+                "d0",
+                std::vector<int64_t>(
+                    points.begin() + start, points.begin() + end));
+        }
+
+        std::set<int64_t> d0;
+        while (auto batch = soma_array->read_next()) {
+            auto d0_batch = (*batch)->at("d0")->data<int64_t>();
+            d0.insert(d0_batch.begin(), d0_batch.end());
+        }
+        REQUIRE(d0 == expected);
+        soma_array->close();
+    }
+}
+
+TEST_CASE("SOMAArray: Partitioned read") {
+    auto preserve_order = GENERATE(false, true);
+    int num_cells = 256;
+
+    std::ostringstream section;
+    section << "- preserve_order=" << preserve_order;
+
+    SECTION(section.str()) {
+        auto ctx = std::make_shared<SOMAContext>();
+        std::string base_uri = "mem://unit-test-array-partitioned-read";
+        auto [uri, expected_nnz] = create_array(base_uri, ctx, num_cells);
+        write_array(uri, ctx, num_cells);
+
+        auto soma_array = SOMAArray::open(OpenMode::read, uri, ctx);
+        soma_array->set_read_partitions(4, preserve_order);
+        soma_array->set_dim_ranges<int64_t>("d0", {{10, 99}, {150, 300}});
+
+        std::vector<int64_t> d0;
+        std::vector<int64_t> batch_min;
+        while (auto batch = soma_array->read_next()) {
+            auto d0_batch = (*batch)->at("d0")->data<int64_t>();
+            d0.insert(d0.end(), d0_batch.begin(), d0_batch.end());
+            if (!d0_batch.empty()) {
+                batch_min.push_back(
+                    *std::min_element(d0_batch.begin(), d0_batch.end()));
+            }
+        }
+
+        std::vector<int64_t> expected(90);
+        std::iota(expected.begin(), expected.end(), 10);
+        for (int64_t i = 150; i < num_cells; i++) {
+            expected.push_back(i);
+        }
+        std::sort(d0.begin(), d0.end());
+        REQUIRE(d0 == expected);
+        REQUIRE(soma_array->results_complete());
+        REQUIRE(soma_array->is_complete(true));
+        REQUIRE(soma_array->total_num_cells() == expected.size());
+
+        // Each partition fits in one batch
+        REQUIRE(batch_min.size() == 4);
+        if (preserve_order) {
+            REQUIRE(std::is_sorted(batch_min.begin(), batch_min.end()));
+        }
+        soma_array->close();
+    }
+}
+
 TEST_CASE("SOMAArray: Enumeration") {
     std::string uri = "mem://unit-test-array-enmr";
     auto ctx = std::make_shared<SOMAContext>();
@@ -474,6 +826,236 @@ TEST_CASE("SOMAArray: Enumeration") {
     REQUIRE(soma_array->attr_has_enum("a"));
 }
 
+TEST_CASE("SOMAArray: Extend enumeration") {
+    std::string uri = "mem://unit-test-array-extend-enmr";
+    auto ctx = std::make_shared<SOMAContext>();
+    ArraySchema schema(*ctx->tiledb_ctx(), TILEDB_SPARSE);
+
+    auto dim = Dimension::create<int64_t>(
+        *ctx->tiledb_ctx(), "d", {0, std::numeric_limits<int64_t>::max() - 1});
+
+    Domain dom(*ctx->tiledb_ctx());
+    dom.add_dimension(dim);
+    schema.set_domain(dom);
+
+    std::vector<std::string> vals = {"red", "blue", "green"};
+    auto enmr = Enumeration::create(*ctx->tiledb_ctx(), "rbg", vals);
+    ArraySchemaExperimental::add_enumeration(*ctx->tiledb_ctx(), schema, enmr);
+
+    auto attr = Attribute::create<int>(*ctx->tiledb_ctx(), "a");
+    AttributeExperimental::set_enumeration_name(
+        *ctx->tiledb_ctx(), attr, "rbg");
+    schema.add_attribute(attr);
+
+    Array::create(uri, std::move(schema));
+
+    // Dictionary ["yellow", "red"] with int8 indexes into it
+    std::string dict_data = "yellowred";
+    std::vector<int32_t> dict_offsets = {0, 6, 9};
+    const void* dict_buffers[] = {
+        nullptr, dict_offsets.data(), dict_data.data()};
+    ArrowSchema value_schema{};
+    value_schema.format = "u";
+    ArrowArray value_array{};
+    value_array.length = 2;
+    value_array.n_buffers = 3;
+    value_array.buffers = dict_buffers;
+
+    std::vector<int8_t> indexes = {0, 1, 1, 0};
+    const void* index_buffers[] = {nullptr, indexes.data()};
+    ArrowSchema index_schema{};
+    index_schema.name = "a";
+    index_schema.format = "c";
+    ArrowArray index_array{};
+    index_array.length = 4;
+    index_array.n_buffers = 2;
+    index_array.buffers = index_buffers;
+
+    auto soma_array = SOMAArray::open(OpenMode::write, uri, ctx);
+    auto extended = soma_array->extend_enumeration(
+        &value_schema, &value_array, &index_schema, &index_array);
+    REQUIRE(
+        extended.as_vector<std::string>() ==
+        std::vector<std::string>({"red", "blue", "green", "yellow"}));
+
+    // The indexes are remapped into the extended enumeration and cast to
+    // the int32 type of the attribute
+    REQUIRE(std::string(index_schema.format) == "i");
+    auto remapped = (const int32_t*)index_array.buffers[1];
+    REQUIRE(
+        std::vector<int32_t>(remapped, remapped + 4) ==
+        std::vector<int32_t>({3, 0, 0, 3}));
+    REQUIRE(indexes == std::vector<int8_t>({0, 1, 1, 0}));
+    soma_array->close();
+}
+
+TEST_CASE("SOMAArray: Extend enumeration with null and invalid indexes") {
+    std::string uri = "mem://unit-test-array-extend-enmr-invalid";
+    auto ctx = std::make_shared<SOMAContext>();
+    auto vfs = VFS(*ctx->tiledb_ctx());
+    if (vfs.is_dir(uri)) {
+        vfs.remove_dir(uri);
+    }
+    ArraySchema schema(*ctx->tiledb_ctx(), TILEDB_SPARSE);
+
+    auto dim = Dimension::create<int64_t>(
+        *ctx->tiledb_ctx(), "d", {0, std::numeric_limits<int64_t>::max() - 1});
+
+    Domain dom(*ctx->tiledb_ctx());
+    dom.add_dimension(dim);
+    schema.set_domain(dom);
+
+    std::vector<std::string> vals = {"red", "blue", "green"};
+    auto enmr = Enumeration::create(*ctx->tiledb_ctx(), "rbg", vals);
+    ArraySchemaExperimental::add_enumeration(*ctx->tiledb_ctx(), schema, enmr);
+
+    auto attr = Attribute::create<int>(*ctx->tiledb_ctx(), "a");
+    attr.set_nullable(true);
+    AttributeExperimental::set_enumeration_name(
+        *ctx->tiledb_ctx(), attr, "rbg");
+    schema.add_attribute(attr);
+
+    Array::create(uri, std::move(schema));
+
+    // Dictionary ["yellow", "red"] with int8 indexes into it
+    std::string dict_data = "yellowred";
+    std::vector<int32_t> dict_offsets = {0, 6, 9};
+    const void* dict_buffers[] = {
+        nullptr, dict_offsets.data(), dict_data.data()};
+    ArrowSchema value_schema{};
+    value_schema.format = "u";
+    ArrowArray value_array{};
+    value_array.length = 2;
+    value_array.n_buffers = 3;
+    value_array.buffers = dict_buffers;
+
+    ArrowSchema index_schema{};
+    index_schema.name = "a";
+    index_schema.format = "c";
+    ArrowArray index_array{};
+    index_array.length = 3;
+    index_array.n_buffers = 2;
+
+    auto soma_array = SOMAArray::open(OpenMode::write, uri, ctx);
+
+    SECTION("Null slots are not remapped") {
+        // The null slot holds an index outside of the dictionary
+        std::vector<int8_t> indexes = {1, 9, 0};
+        uint8_t validity = 0b101;
+        const void* index_buffers[] = {&validity, indexes.data()};
+        index_array.null_count = 1;
+        index_array.buffers = index_buffers;
+        soma_array->extend_enumeration(
+            &value_schema, &value_array, &index_schema, &index_array);
+
+        auto remapped = (const int32_t*)index_array.buffers[1];
+        REQUIRE(remapped[0] == 0);
+        REQUIRE(remapped[2] == 3);
+    }
+
+    SECTION("Indexes outside of the dictionary throw") {
+        std::vector<int8_t> indexes = {GENERATE(2, -1), 1, 0};
+        const void* index_buffers[] = {nullptr, indexes.data()};
+        index_array.buffers = index_buffers;
+        REQUIRE_THROWS_AS(
+            soma_array->extend_enumeration(
+                &value_schema, &value_array, &index_schema, &index_array),
+            TileDBSOMAError);
+    }
+    soma_array->close();
+}
+
+TEST_CASE("SOMAArray: Write sliced enumeration") {
+    std::string uri = "mem://unit-test-array-write-sliced-enmr";
+    auto ctx = std::make_shared<SOMAContext>();
+    ArraySchema schema(*ctx->tiledb_ctx(), TILEDB_SPARSE);
+
+    auto dim = Dimension::create<int64_t>(
+        *ctx->tiledb_ctx(), "d", {0, std::numeric_limits<int64_t>::max() - 1});
+
+    Domain dom(*ctx->tiledb_ctx());
+    dom.add_dimension(dim);
+    schema.set_domain(dom);
+
+    std::vector<std::string> vals = {"red", "blue", "green"};
+    auto enmr = Enumeration::create(*ctx->tiledb_ctx(), "rbg", vals);
+    ArraySchemaExperimental::add_enumeration(*ctx->tiledb_ctx(), schema, enmr);
+
+    auto attr = Attribute::create<int>(*ctx->tiledb_ctx(), "a");
+    AttributeExperimental::set_enumeration_name(
+        *ctx->tiledb_ctx(), attr, "rbg");
+    schema.add_attribute(attr);
+
+    Array::create(uri, std::move(schema));
+
+    // Dictionary ["yellow", "red"] with int8 indexes into it
+    std::string dict_data = "yellowred";
+    std::vector<int32_t> dict_offsets = {0, 6, 9};
+    const void* dict_buffers[] = {
+        nullptr, dict_offsets.data(), dict_data.data()};
+    ArrowSchema value_schema{};
+    value_schema.format = "u";
+    ArrowArray value_array{};
+    value_array.length = 2;
+    value_array.n_buffers = 3;
+    value_array.buffers = dict_buffers;
+
+    std::vector<int64_t> d = {0, 1, 2, 3, 4, 5};
+    const void* d_buffers[] = {nullptr, d.data()};
+    ArrowSchema d_schema{};
+    d_schema.name = "d";
+    d_schema.format = "l";
+    ArrowArray d_array{};
+    d_array.length = 3;
+    d_array.offset = 2;
+    d_array.n_buffers = 2;
+    d_array.buffers = d_buffers;
+
+    std::vector<int8_t> indexes = {0, 0, 1, 0, 1, 1};
+    const void* index_buffers[] = {nullptr, indexes.data()};
+    ArrowSchema index_schema{};
+    index_schema.name = "a";
+    index_schema.format = "c";
+    index_schema.dictionary = &value_schema;
+    ArrowArray index_array{};
+    index_array.length = 3;
+    index_array.offset = 2;
+    index_array.n_buffers = 2;
+    index_array.buffers = index_buffers;
+    index_array.dictionary = &value_array;
+
+    // Rows 2 to 4 of the table
+    ArrowSchema* schema_children[] = {&d_schema, &index_schema};
+    auto table_schema = std::make_unique<ArrowSchema>();
+    table_schema->format = "+s";
+    table_schema->n_children = 2;
+    table_schema->children = schema_children;
+    ArrowArray* array_children[] = {&d_array, &index_array};
+    auto table_array = std::make_unique<ArrowArray>();
+    table_array->length = 3;
+    table_array->n_children = 2;
+    table_array->children = array_children;
+
+    auto soma_array = SOMAArray::open(OpenMode::write, uri, ctx);
+    soma_array->set_array_data(std::move(table_schema), std::move(table_array));
+    soma_array->write();
+    soma_array->close();
+
+    // "red" and "yellow" are codes 0 and 3 of the extended enumeration
+    soma_array = SOMAArray::open(OpenMode::read, uri, ctx);
+    auto batch = soma_array->read_next();
+    REQUIRE(batch.has_value());
+    auto d_read = (*batch)->at("d")->data<int64_t>();
+    auto a_read = (*batch)->at("a")->data<int32_t>();
+    REQUIRE(
+        std::vector<int64_t>(d_read.begin(), d_read.end()) ==
+        std::vector<int64_t>({2, 3, 4}));
+    REQUIRE(
+        std::vector<int32_t>(a_read.begin(), a_read.end()) ==
+        std::vector<int32_t>({0, 3, 0}));
+    soma_array->close();
+}
+
 TEST_CASE("SOMAArray: ResultOrder") {
     auto ctx = std::make_shared<SOMAContext>();
     std::string base_uri = "mem://unit-test-array-result-order";
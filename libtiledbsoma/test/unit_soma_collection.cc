@@ -256,6 +256,66 @@ TEST_CASE("SOMACollection: add SOMAMeasurement") {
     soma_collection->close();
 }
 
+TEST_CASE("SOMACollection: member cache") {
+    auto ctx = std::make_shared<SOMAContext>(
+        std::map<std::string, std::string>{
+            {"sm.compute_concurrency_level", "4"}});
+    std::string base_uri = "mem://unit-test-member-cache";
+    std::string sparse_uri = "mem://unit-test-member-cache/sparse";
+    std::string sub_uri = "mem://unit-test-member-cache/sub";
+
+    SOMACollection::create(base_uri, ctx);
+    auto index_columns = helper::create_column_index_info();
+    auto soma_collection = SOMACollection::open(base_uri, OpenMode::write, ctx);
+    soma_collection->add_new_sparse_ndarray(
+        "sparse_ndarray",
+        sparse_uri,
+        URIType::absolute,
+        ctx,
+        "l",
+        ArrowTable(
+            std::move(index_columns.first), std::move(index_columns.second)));
+    auto added = soma_collection->add_new_collection(
+        "subcollection", sub_uri, URIType::absolute, ctx);
+    soma_collection->close();
+    REQUIRE(!added->is_open());
+
+    // Cached members are kept apart from the members added by add_new_*
+    soma_collection = SOMACollection::open(base_uri, OpenMode::read, ctx);
+    auto sparse = soma_collection->get("sparse_ndarray");
+    REQUIRE(sparse->uri() == sparse_uri);
+    REQUIRE(soma_collection->begin() == soma_collection->end());
+    REQUIRE(soma_collection->get("sparse_ndarray") == sparse);
+
+    auto members = soma_collection->open_all(
+        {"subcollection", "sparse_ndarray", "subcollection"});
+    REQUIRE(members.size() == 3);
+    REQUIRE(members[0]->uri() == sub_uri);
+    REQUIRE(members[0]->type() == "SOMACollection");
+    REQUIRE(members[1] == sparse);
+    REQUIRE(members[2] == members[0]);
+    REQUIRE(soma_collection->open_all().size() == 2);
+    soma_collection->close();
+
+    // Members held by callers stay open, but are dropped from the cache
+    REQUIRE(sparse->is_open());
+    sparse->close();
+    soma_collection->open(OpenMode::read);
+    auto reopened = soma_collection->get("sparse_ndarray");
+    REQUIRE(reopened != sparse);
+    REQUIRE(reopened->is_open());
+
+    // A member reopened for write is not returned for read
+    reopened->close();
+    std::dynamic_pointer_cast<SOMAArray>(reopened)->open(OpenMode::write);
+    auto for_read = soma_collection->get("sparse_ndarray");
+    REQUIRE(for_read != reopened);
+    REQUIRE(for_read->mode() == OpenMode::read);
+    reopened->close();
+    REQUIRE_THROWS(soma_collection->open_all({"sparse_ndarray", "missing"}));
+    soma_collection->close();
+}
+
 TEST_CASE("SOMACollection: metadata") {
     auto ctx = std::make_shared<SOMAContext>();
 
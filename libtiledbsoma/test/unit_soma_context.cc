@@ -0,0 +1,94 @@
+/**
+ * @file   unit_soma_context.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2024 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file manages unit tests for the SOMAContext class
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <tiledb/tiledb>
+#include <tiledbsoma/tiledbsoma>
+
+using namespace tiledb;
+using namespace tiledbsoma;
+
+TEST_CASE("SOMAContext: cached contexts") {
+    std::map<std::string, std::string> config{
+        {"sm.compute_concurrency_level", "4"}};
+    SOMAContext::clear_cache();
+
+    auto ctx = SOMAContext::cached(config);
+    REQUIRE(ctx->tiledb_config()["sm.compute_concurrency_level"] == "4");
+
+    // The same config returns the same context and thread pool
+    auto same = SOMAContext::cached(config);
+    REQUIRE(same == ctx);
+    REQUIRE(same->thread_pool() == ctx->thread_pool());
+
+    // A different config gets its own context
+    auto other = SOMAContext::cached({{"sm.compute_concurrency_level", "2"}});
+    REQUIRE(other != ctx);
+
+    // Parameters set to their default value share the default context
+    auto defaults = SOMAContext::cached();
+    auto default_value = defaults->tiledb_config()["sm.io_concurrency_level"];
+    REQUIRE(
+        SOMAContext::cached({{"sm.io_concurrency_level", default_value}}) ==
+        defaults);
+
+    // Clearing the cache leaves contexts in use alive
+    SOMAContext::clear_cache();
+    REQUIRE(SOMAContext::cached(config) != ctx);
+    REQUIRE(ctx->tiledb_ctx() != nullptr);
+}
+
+TEST_CASE("SOMAContext: cached context eviction") {
+    auto config = [](size_t i) {
+        return std::map<std::string, std::string>{
+            {"sm.compute_concurrency_level", std::to_string(i + 1)}};
+    };
+    SOMAContext::clear_cache();
+
+    std::vector<std::shared_ptr<SOMAContext>> contexts;
+    for (size_t i = 0; i < SOMAContext::MAX_CACHED_CONTEXTS; i++) {
+        contexts.push_back(SOMAContext::cached(config(i)));
+    }
+
+    // Using the oldest context makes the second one least recently used
+    REQUIRE(SOMAContext::cached(config(0)) == contexts[0]);
+    SOMAContext::cached(config(SOMAContext::MAX_CACHED_CONTEXTS));
+    REQUIRE(SOMAContext::cached(config(0)) == contexts[0]);
+    REQUIRE(SOMAContext::cached(config(1)) != contexts[1]);
+
+    // An evicted context is released once its last user lets go of it
+    std::weak_ptr<SOMAContext> evicted = contexts[1];
+    contexts[1].reset();
+    REQUIRE(evicted.expired());
+    SOMAContext::clear_cache();
+}
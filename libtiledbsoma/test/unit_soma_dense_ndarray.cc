@@ -74,6 +74,11 @@ TEST_CASE("SOMADenseNDArray: basic") {
         auto a0span = arrbuf->at("soma_data")->data<int>();
         REQUIRE(a0 == std::vector<int>(a0span.begin(), a0span.end()));
     }
+
+    // Only the written cells are reduced, not the whole domain
+    REQUIRE(
+        soma_dense->aggregate("soma_data", AggregateOp::count) ==
+        AggregateValue{uint64_t{10}});
     soma_dense->close();
 }
 
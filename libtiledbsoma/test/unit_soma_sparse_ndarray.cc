@@ -175,4 +175,59 @@ TEST_CASE("SOMASparseNDArray: metadata") {
     soma_sparse->open(OpenMode::read, TimestampRange(0, 2));
     REQUIRE(!soma_sparse->has_metadata("md"));
     REQUIRE(soma_sparse->metadata_num() == 2);
-}
\ No newline at end of file
+}
+TEST_CASE("SOMASparseNDArray: reduce_axis") {
+    auto ctx = std::make_shared<SOMAContext>();
+    std::string uri = "mem://unit-test-sparse-ndarray-reduce-axis";
+
+    auto index_columns = helper::create_column_index_info();
+    SOMASparseNDArray::create(
+        uri,
+        "l",
+        ArrowTable(
+            std::move(index_columns.first), std::move(index_columns.second)),
+        ctx);
+
+    std::vector<int64_t> d0(10);
+    std::vector<int64_t> a0(10);
+    for (int j = 0; j < 10; j++) {
+        d0[j] = j;
+        a0[j] = j + 1;
+    }
+
+    auto soma_sparse = SOMASparseNDArray::open(uri, OpenMode::write, ctx);
+    soma_sparse->set_column_data("soma_data", a0.size(), a0.data());
+    soma_sparse->set_column_data("soma_dim_0", d0.size(), d0.data());
+    soma_sparse->write();
+    soma_sparse->close();
+
+    soma_sparse->open(OpenMode::read);
+    REQUIRE_THROWS_AS(soma_sparse->reduce_axis(1), TileDBSOMAError);
+
+    // Only the cells at 2 ... 5 are reduced, the rest of the non-empty domain
+    // is returned empty
+    soma_sparse->set_dim_ranges<int64_t>("soma_dim_0", {{2, 5}});
+    auto result = soma_sparse->reduce_axis(0);
+    REQUIRE(result->num_rows() == 10);
+
+    auto joinids = result->at("soma_joinid")->data<int64_t>();
+    auto nnz = result->at("nnz")->data<uint64_t>();
+    auto sum = result->at("sum")->data<double>();
+    auto sum_sq = result->at("sum_sq")->data<double>();
+    auto min = result->at("min");
+    auto max = result->at("max");
+    for (int64_t i = 0; i < 10; i++) {
+        bool selected = i >= 2 && i <= 5;
+        REQUIRE(joinids[i] == i);
+        REQUIRE(nnz[i] == (selected ? 1 : 0));
+        REQUIRE(sum[i] == (selected ? i + 1 : 0));
+        REQUIRE(sum_sq[i] == (selected ? (i + 1) * (i + 1) : 0));
+        REQUIRE(min->validity()[i] == selected);
+        REQUIRE(max->validity()[i] == selected);
+        if (selected) {
+            REQUIRE(min->data<double>()[i] == i + 1);
+            REQUIRE(max->data<double>()[i] == i + 1);
+        }
+    }
+    soma_sparse->close();
+}
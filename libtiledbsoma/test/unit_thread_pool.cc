@@ -492,3 +492,135 @@ TEST_CASE("ThreadPool: Test Exceptions", "[threadpool]") {
         REQUIRE(result == 207);
     }
 }
+
+/**
+ * Occupy one worker of `pool` until `release` is set, returning once the
+ * worker is running the task.
+ */
+ThreadPool::Task block_worker(
+    ThreadPool& pool, std::shared_future<void> release) {
+    auto started = std::make_shared<std::promise<void>>();
+    auto task = pool.execute([started, release]() {
+        started->set_value();
+        release.wait();
+        return Status::Ok();
+    });
+    started->get_future().wait();
+    return task;
+}
+
+TEST_CASE("ThreadPool: Test tasks scheduled by a worker", "[threadpool]") {
+    ThreadPool pool{2};
+    std::promise<void> release;
+    auto blocker = block_worker(pool, release.get_future().share());
+
+    // The only free worker schedules the children on its own deque and runs
+    // them newest first while it waits for them
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+    auto parent = pool.execute([&pool, &order, &threads]() {
+        std::vector<ThreadPool::Task> children;
+        for (int i = 0; i < 4; i++) {
+            children.push_back(pool.execute([i, &order, &threads]() {
+                order.push_back(i);
+                threads.push_back(std::this_thread::get_id());
+                return Status::Ok();
+            }));
+        }
+        auto st = pool.wait_all(children);
+        threads.push_back(std::this_thread::get_id());
+        return st;
+    });
+
+    // Wait without helping, so that only the workers run the tasks
+    REQUIRE(parent.get().ok());
+    REQUIRE(order == std::vector<int>{3, 2, 1, 0});
+    REQUIRE(threads.size() == 5);
+    for (auto& id : threads) {
+        REQUIRE(id == threads.back());
+    }
+
+    release.set_value();
+    REQUIRE(blocker.get().ok());
+}
+
+TEST_CASE("ThreadPool: Test work stealing", "[threadpool]") {
+    ThreadPool pool{2};
+    std::promise<void> release;
+    auto blocker = block_worker(pool, release.get_future().share());
+
+    // Half of the tasks land on the deque of the blocked worker, and are
+    // stolen by the other one
+    std::atomic<int> result(0);
+    std::vector<ThreadPool::Task> tasks;
+    for (int i = 0; i < 20; i++) {
+        tasks.push_back(pool.execute([&result]() {
+            ++result;
+            return Status::Ok();
+        }));
+    }
+    for (auto& task : tasks) {
+        REQUIRE(
+            task.wait_for(std::chrono::seconds(10)) ==
+            std::future_status::ready);
+        REQUIRE(task.get().ok());
+    }
+    REQUIRE(result == 20);
+
+    release.set_value();
+    REQUIRE(blocker.get().ok());
+}
+
+TEST_CASE("ThreadPool: Test wait_all_status on nested tasks", "[threadpool]") {
+    ThreadPool pool{1};
+
+    // The single worker runs the parent, so the children only complete if
+    // wait_all_status runs them while it waits
+    std::vector<Status> statuses;
+    auto parent = pool.execute([&pool, &statuses]() {
+        std::vector<ThreadPool::Task> children;
+        for (int i = 0; i < 5; i++) {
+            children.push_back(pool.execute([i]() {
+                if (i == 3) {
+                    return Status_TaskError("Child failed");
+                }
+                return Status::Ok();
+            }));
+        }
+        statuses = pool.wait_all_status(children);
+        return Status::Ok();
+    });
+    REQUIRE(
+        parent.wait_for(std::chrono::seconds(10)) ==
+        std::future_status::ready);
+    REQUIRE(parent.get().ok());
+
+    REQUIRE(statuses.size() == 5);
+    for (size_t i = 0; i < statuses.size(); i++) {
+        REQUIRE(statuses[i].ok() == (i != 3));
+    }
+}
+
+TEST_CASE("ThreadPool: Test shutdown drains the deques", "[threadpool]") {
+    std::atomic<int> result(0);
+    std::promise<void> release;
+    std::thread releaser;
+    {
+        ThreadPool pool{1};
+        auto blocker = block_worker(pool, release.get_future().share());
+        for (int i = 0; i < 10; i++) {
+            pool.execute([&result]() {
+                ++result;
+                return Status::Ok();
+            });
+        }
+
+        // Release the worker once the pool is shutting down
+        releaser = std::thread([&release]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            release.set_value();
+        });
+    }
+    releaser.join();
+    REQUIRE(result == 10);
+}